@@ -0,0 +1,117 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Bitboard.h"
+#include "Codec.h"
+#include "Deck.h"
+#include "Deal.h"
+
+#include <algorithm>
+#include <functional>
+
+    constexpr Bitboard::Mask Bitboard::SUIT;
+    constexpr Bitboard::Mask Bitboard::ALL;
+    constexpr Bitboard::Mask Bitboard::ACES;
+    constexpr Bitboard::Mask Bitboard::KINGS;
+    constexpr Bitboard::Mask Bitboard::QUEENS;
+    constexpr Bitboard::Mask Bitboard::JACKS;
+
+namespace
+{
+    char const  Cards[] = "AKQJT98765432";
+}
+
+    Bitboard&
+    Bitboard::fr_deck( Deck const& deck )
+    {
+        hands_ = {{0, 0, 0, 0}};
+        for ( int _slot{0}; _slot < 52; ++_slot )
+        {
+            int const   _seat{deck[_slot]};
+            if ( _seat ) { hand( _seat ) |= card( _slot ); }
+        }
+        return *this;
+    }
+
+    Deck&
+    Bitboard::to_deck( Deck& deck ) const
+    {
+        for ( int _slot{0}; _slot < 52; ++_slot ) { deck[_slot] = who( _slot ); }
+        return deck;
+    }
+
+    // hex 2-bit chunks are seats SWNE 0..3, i.e. hands_ index (chunk + 3) % 4
+    bool
+    Bitboard::load_hex( char const* hex )
+    {
+        hands_ = {{0, 0, 0, 0}};
+        for ( int _rank{0}; _rank < 13; ++_rank )
+        {
+            int const   _e{DeckCodec::hex_value( *hex++ )};
+            int const   _o{DeckCodec::hex_value( *hex++ )};
+            if ( (_e | _o) < 0 ) { return false; }
+            int const   _bit{12 - _rank};
+            hands_[((_e & 3) + 3) & 3]        |= Mask(1) << _bit;
+            hands_[(((_e >> 2) & 3) + 3) & 3] |= Mask(1) << (_bit + 16);
+            hands_[((_o & 3) + 3) & 3]        |= Mask(1) << (_bit + 32);
+            hands_[(((_o >> 2) & 3) + 3) & 3] |= Mask(1) << (_bit + 48);
+        }
+        return complete();
+    }
+
+    char*
+    Bitboard::store_hex( char* hex, std::size_t len ) const
+    {
+        if ( len > 0 && len < 27 ) { return hex; }
+        for ( int _rank{0}; _rank < 13; ++_rank )
+        {
+            *hex++ = DeckCodec::hex_digit( who( _rank ) % 4 | (who( _rank + 13 ) % 4) << 2 );
+            *hex++ = DeckCodec::hex_digit( who( _rank + 26 ) % 4 | (who( _rank + 39 ) % 4) << 2 );
+        }
+        *hex = '\0';
+        return hex;
+    }
+
+    Deal&
+    Bitboard::to_deal( Deal& deal ) const
+    {
+        deal.reset();
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            unsigned const  _holding{holding( _seat, _suit )};
+            for ( int _rank{0}; _rank < 13; ++_rank )
+            {
+                if ( _holding & (1u << (12 - _rank)) ) { deal[_seat - 1][_suit].add( Cards[_rank] ); }
+            }
+        }
+        return deal;
+    }
+
+    bool
+    Bitboard::fr_deal( Deal const& deal )
+    {
+        hands_ = {{0, 0, 0, 0}};
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            for ( char const* _card{deal[_seat - 1][_suit].get()}; *_card; ++_card )
+            {
+                char const* _rank{std::find( Cards, Cards + 13, *_card )};
+                if ( _rank == Cards + 13 ) { return false; }
+                hand( _seat ) |= card( 13 * _suit + int(_rank - Cards) );
+            }
+        }
+        return true;
+    }
+
+    Bitboard::Shape
+    Bitboard::pattern( int seat ) const
+    {
+        Shape   _shape(shape( seat ));
+        std::sort( _shape.begin(), _shape.end(), std::greater<int>() );
+        return _shape;
+    }
@@ -0,0 +1,114 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_BITBOARD_H
+#define BRIDGE_BITBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+class Deck;
+class Deal;
+
+    /**
+     * @class Bitboard
+     * @brief Packed layout: one 64-bit mask per seat (32 bytes in all).
+     * Each suit (SHDC) has a 16-bit lane, low 13 bits used, ace highest:
+     *   bit = 16 * suit + (12 - rank)  where rank 0..12 <-> A..2
+     * so Deck slot n is bit 16 * (n / 13) + 12 - (n % 13).
+     * Seats are WNES 1..4 as in Deck; 0 (out of play) has no bits.
+     */
+    class Bitboard
+    {
+    public:
+        using Mask  = std::uint64_t;
+        using Shape = std::array<int, 4>; //!< S H D C lengths
+
+        static constexpr Mask SUIT   = 0x1FFFull;
+        static constexpr Mask ALL    = SUIT | SUIT << 16 | SUIT << 32 | SUIT << 48;
+        static constexpr Mask ACES   = 0x1000100010001000ull;
+        static constexpr Mask KINGS  = ACES >> 1;
+        static constexpr Mask QUEENS = ACES >> 2;
+        static constexpr Mask JACKS  = ACES >> 3;
+
+        ~Bitboard() noexcept = default;
+        Bitboard() = default;
+        explicit
+        Bitboard(Deck const& deck) { fr_deck( deck ); }
+        explicit
+        Bitboard(char const* hex) { load_hex( hex ); }
+
+        //!> conversions
+        Bitboard& fr_deck( Deck const& );
+        Deck&     to_deck( Deck& ) const;
+        bool      fr_deal( Deal const& );
+        Deal&     to_deal( Deal& ) const;
+        bool      load_hex( char const* );
+        char*     store_hex( char*, std::size_t = 0 ) const;
+
+        static int  bit( int slot ) { return 16 * (slot / 13) + 12 - slot % 13; }
+        static int  slot( int bit ) { return 13 * (bit >> 4) + 12 - (bit & 15); }
+        static Mask card( int slot ) { return Mask(1) << bit( slot ); }
+
+        Mask  hand( int seat ) const { return hands_[(seat - 1) & 3]; }
+        Mask& hand( int seat )       { return hands_[(seat - 1) & 3]; }
+        //!> 13-bit rank mask of a holding, ace = bit 12
+        unsigned holding( int seat, int suit ) const { return (hand( seat ) >> (16 * suit)) & SUIT; }
+
+        //!> seat holding the card in Deck slot 'slot', 0 if out of play
+        int who( int slot ) const
+        {
+            Mask const  _card{card( slot )};
+            return (hands_[0] & _card) ? 1 : (hands_[1] & _card) ? 2
+                 : (hands_[2] & _card) ? 3 : (hands_[3] & _card) ? 4 : 0;
+        }
+
+        //!> card play: moves the card out of play, returns its seat
+        int play( int slot )
+        {
+            int const   _seat{who( slot )};
+            if ( _seat ) { hand( _seat ) &= ~card( slot ); }
+            return _seat;
+        }
+        void restore( int slot, int seat ) { hand( seat ) |= card( slot ); }
+
+        int count( int seat ) const { return popcount( hand( seat ) ); }
+        int length( int seat, int suit ) const { return popcount( hand( seat ) & SUIT << (16 * suit) ); }
+        Shape shape( int seat ) const
+        {
+            Mask const  _hand{hand( seat )};
+            return {{ popcount( _hand & SUIT ),       popcount( _hand & SUIT << 16 ),
+                      popcount( _hand & SUIT << 32 ), popcount( _hand & SUIT << 48 ) }};
+        }
+        //!> lengths sorted longest first, e.g. 5431
+        Shape pattern( int seat ) const;
+        int hcp( int seat ) const
+        {
+            Mask const  _hand{hand( seat )};
+            return 4 * popcount( _hand & ACES )   + 3 * popcount( _hand & KINGS )
+                 + 2 * popcount( _hand & QUEENS ) +     popcount( _hand & JACKS );
+        }
+        //!> all four at once, WNES order
+        void hcp( int* pts ) const { for ( int _seat{1}; _seat <= 4; ++_seat ) { *pts++ = hcp( _seat ); } }
+
+        bool complete() const
+        {
+            return (hands_[0] | hands_[1] | hands_[2] | hands_[3]) == ALL
+                && count( 1 ) == 13 && count( 2 ) == 13 && count( 3 ) == 13 && count( 4 ) == 13;
+        }
+
+        bool operator==( Bitboard const& other ) const { return hands_ == other.hands_; }
+        bool operator!=( Bitboard const& other ) const { return hands_ != other.hands_; }
+
+        static int popcount( Mask mask ) { return __builtin_popcountll( mask ); }
+
+    private:
+        std::array<Mask, 4>     hands_{{0, 0, 0, 0}}; //!< W N E S
+    };
+
+#endif // BRIDGE_BITBOARD_H
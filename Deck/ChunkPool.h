@@ -0,0 +1,107 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_CHUNKPOOL_H
+#define BRIDGE_CHUNKPOOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+    /**
+     * @class ChunkPool
+     * @brief A text buffer worked on in chunks by a pool of threads, with
+     * the results taken back in order on the calling thread.
+     * split() cuts the buffer at line boundaries; run() hands the chunks
+     * out to the workers, at most two per worker ahead of the sink, so a
+     * large input is never all held as results at once.
+     */
+    class ChunkPool
+    {
+    public:
+        //!> chunks of about 'size' bytes, each ending after a newline (or at
+        //!> the end); Chunk is made from its (begin, end)
+        template<typename Chunk>
+        static std::vector<Chunk> split( char const* buf, std::size_t len, std::size_t size )
+        {
+            std::vector<Chunk>  _chunks;
+            for ( char const* _ptr{buf}, *_end{buf + len}; _ptr < _end; )
+            {
+                char const* _stop{_end - _ptr > static_cast<std::ptrdiff_t>(size) ? _ptr + size : _end};
+                if ( _stop < _end )
+                {
+                    char const* _eol = static_cast<char const*>(std::memchr( _stop, '\n', _end - _stop ));
+                    _stop = _eol ? _eol + 1 : _end;
+                }
+                _chunks.emplace_back( _ptr, _stop );
+                _ptr = _stop;
+            }
+            return _chunks;
+        }
+
+        //!> work( n ) for n in [0, count) on up to 'threads' workers, and
+        //!> sink( n ) here in order of n as each is done
+        template<typename Work, typename Sink>
+        static void run( std::size_t count, unsigned threads, Work&& work, Sink&& sink )
+        {
+            if ( count == 0 ) { return; }
+            threads = static_cast<unsigned>(std::max<std::size_t>( 1, std::min<std::size_t>( threads, count ) ));
+
+            std::mutex              _mx;
+            std::condition_variable _cv;
+            std::size_t             _take{0};
+            std::size_t             _given{0};
+            std::size_t const       _window{2 * static_cast<std::size_t>(threads)};
+            std::unique_ptr<bool[]> _done(new bool[count]());
+
+            std::vector<std::thread>    _pool;
+            for ( unsigned _ndx{0}; _ndx < threads; ++_ndx )
+            {
+                _pool.emplace_back( [&]()
+                {
+                    for ( ;; )
+                    {
+                        std::size_t _next;
+                        {
+                            std::unique_lock<std::mutex>    _lock(_mx);
+                            _cv.wait( _lock, [&]() { return _take >= count || _take < _given + _window; } );
+                            if ( _take >= count ) { return; }
+                            _next = _take++;
+                        }
+                        work( _next );
+                        {
+                            std::lock_guard<std::mutex>     _guard(_mx);
+                            _done[_next] = true;
+                        }
+                        _cv.notify_all();
+                    }
+                });
+            }
+
+            for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+            {
+                {
+                    std::unique_lock<std::mutex>    _lock(_mx);
+                    _cv.wait( _lock, [&]() { return _done[_ndx]; } );
+                }
+                sink( _ndx );
+                {
+                    std::lock_guard<std::mutex>     _guard(_mx);
+                    ++_given;
+                }
+                _cv.notify_all();
+            }
+            for ( auto& _thread : _pool ) { _thread.join(); }
+        }
+    };
+
+#endif // BRIDGE_CHUNKPOOL_H
@@ -0,0 +1,516 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Codec.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CODEC_X86 1
+#endif
+
+namespace
+{
+    enum { HEXLEN = 26 };
+
+    constexpr DeckCodec::HexValues make_hex_values()
+    {
+        DeckCodec::HexValues    _h{};
+        for ( int _c{0}; _c < 256; ++_c ) { _h.at[_c] = -1; }
+        for ( int _c{'0'}; _c <= '9'; ++_c ) { _h.at[_c] = _c - '0'; }
+        for ( int _c{'A'}; _c <= 'F'; ++_c ) { _h.at[_c] = _c - 'A' + 10; }
+        for ( int _c{'a'}; _c <= 'f'; ++_c ) { _h.at[_c] = _c - 'a' + 10; }
+        return _h;
+    }
+
+    // hex 2-bit chunk (SWNE) -> Deck seat (WNES 1..4)
+    constexpr int seatOf[4] = { 4, 1, 2, 3 };
+
+    inline int hexit( char c ) { return DeckCodec::hex_value( c ); }
+
+//-------------------------------------------------------------------------
+// scalar kernels
+//-------------------------------------------------------------------------
+
+    bool decode_scalar( int* deck, char const* hex )
+    {
+        std::array<int, 5>  _counts{0, 0, 0, 0, 0};
+        int                 _bad{0};
+
+        for ( int _ndx{0}; _ndx < 13; ++_ndx )
+        {
+            int _e{hexit( *hex++ )};
+            int _o{hexit( *hex++ )};
+            _bad |= _e | _o; // sign bit sticks
+            ++_counts[deck[_ndx]      = seatOf[_e & 3]];
+            ++_counts[deck[_ndx + 13] = seatOf[(_e >> 2) & 3]];
+            ++_counts[deck[_ndx + 26] = seatOf[_o & 3]];
+            ++_counts[deck[_ndx + 39] = seatOf[(_o >> 2) & 3]];
+        }
+        return _bad >= 0
+            && _counts[1] == 13 && _counts[2] == 13
+            && _counts[3] == 13 && _counts[4] == 13;
+    }
+
+    bool verify_scalar( char const* hex )
+    {
+        std::array<int, 4>  _counts{0, 0, 0, 0};
+        char const*         _end = hex + HEXLEN;
+
+        do {
+            int _h{hexit( *hex )};
+            if ( _h < 0 ) { return false; }
+            ++_counts[_h & 3];
+            ++_counts[_h >> 2];
+        } while ( ++hex < _end );
+
+        for ( auto const& _count : _counts ) if ( _count != 13 ) { return false; }
+        return true;
+    }
+
+    void encode_scalar( char* hex, int const* deck )
+    {
+        int const* s = deck;
+        int const* h = deck + 13;
+        int const* d = deck + 26;
+        int const* c = deck + 39;
+        char const* _end = hex + HEXLEN;
+
+        while ( hex < _end )
+        {
+            *hex++ = DeckCodec::hex_digit( (*s++ % 4) | (*h++ % 4) << 2 );
+            *hex++ = DeckCodec::hex_digit( (*d++ % 4) | (*c++ % 4) << 2 );
+        }
+    }
+
+#ifdef CODEC_X86
+//-------------------------------------------------------------------------
+// SSE4.1 kernels: one record per pass.
+// The 26 chars are covered by two overlapping loads at 0 and 10; the
+// even/odd chars (SH/DC) are gathered into lanes 0..12 by pshufb.
+//-------------------------------------------------------------------------
+
+#define SSE41 __attribute__((target("sse4.1")))
+#define AVX2  __attribute__((target("avx2")))
+
+    // lanes 0..12 <- chars 0,2,..,24 (even) and 1,3,..,25 (odd)
+    alignas(16) constexpr signed char evenLo[16] = {  0,  2,  4,  6,  8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1 };
+    alignas(16) constexpr signed char evenHi[16] = { -1, -1, -1, -1, -1, -1, -1, -1,  6,  8, 10, 12, 14, -1, -1, -1 };
+    alignas(16) constexpr signed char oddLo[16]  = {  1,  3,  5,  7,  9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1 };
+    alignas(16) constexpr signed char oddHi[16]  = { -1, -1, -1, -1, -1, -1, -1, -1,  7,  9, 11, 13, 15, -1, -1, -1 };
+    alignas(16) constexpr signed char seatLut[16] = { 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3 };
+    alignas(16) constexpr signed char lane13[16] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0 };
+    alignas(16) constexpr char const  hexLut[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+
+    template<typename T>
+    inline __m128i ld128( T const* ptr ) { return _mm_load_si128( reinterpret_cast<__m128i const*>(ptr) ); }
+
+    //!> ASCII hex -> nibble, flagging anything else in 'bad'
+    SSE41 inline
+    __m128i nibbles( __m128i x, __m128i& bad )
+    {
+        __m128i const _dg  = _mm_sub_epi8( x, _mm_set1_epi8( '0' ) );
+        __m128i const _al  = _mm_sub_epi8( _mm_or_si128( x, _mm_set1_epi8( 0x20 ) ), _mm_set1_epi8( 'a' ) );
+        __m128i const _isd = _mm_cmpeq_epi8( _mm_min_epu8( _dg, _mm_set1_epi8( 9 ) ), _dg );
+        __m128i const _isa = _mm_cmpeq_epi8( _mm_min_epu8( _al, _mm_set1_epi8( 5 ) ), _al );
+        bad = _mm_or_si128( bad, _mm_xor_si128( _mm_or_si128( _isd, _isa ), _mm_set1_epi8( -1 ) ) );
+        return _mm_blendv_epi8( _mm_add_epi8( _al, _mm_set1_epi8( 10 ) ), _dg, _isd );
+    }
+
+    SSE41 inline
+    void store13( int* out, __m128i v )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(out),     _mm_cvtepu8_epi32( v ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu8_epi32( _mm_srli_si128( v, 4 ) ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(out + 8), _mm_cvtepu8_epi32( _mm_srli_si128( v, 8 ) ) );
+        out[12] = _mm_extract_epi8( v, 12 );
+    }
+
+    //!> per-seat tallies of four 13-lane seat vectors; true if 13 each
+    SSE41 inline
+    bool counts_ok( __m128i s, __m128i h, __m128i d, __m128i c )
+    {
+        __m128i _ok{_mm_set1_epi8( -1 )};
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            __m128i const _k{_mm_set1_epi8( _seat )};
+            __m128i _n = _mm_sub_epi8( _mm_setzero_si128(), _mm_cmpeq_epi8( s, _k ) );
+            _n = _mm_sub_epi8( _n, _mm_cmpeq_epi8( h, _k ) );
+            _n = _mm_sub_epi8( _n, _mm_cmpeq_epi8( d, _k ) );
+            _n = _mm_sub_epi8( _n, _mm_cmpeq_epi8( c, _k ) );
+            _n = _mm_sad_epu8( _n, _mm_setzero_si128() );
+            _n = _mm_add_epi64( _n, _mm_srli_si128( _n, 8 ) );
+            _ok = _mm_and_si128( _ok, _mm_cmpeq_epi64( _n, _mm_set_epi64x( 0, 13 ) ) );
+        }
+        return (_mm_movemask_epi8( _ok ) & 0xFF) == 0xFF;
+    }
+
+    //!> the four suits as seat vectors, lanes 13..15 cleared
+    SSE41 inline
+    bool seats_sse( char const* hex, __m128i& s, __m128i& h, __m128i& d, __m128i& c )
+    {
+        __m128i         _bad{_mm_setzero_si128()};
+        __m128i const   _a = nibbles( _mm_loadu_si128( reinterpret_cast<__m128i const*>(hex) ), _bad );
+        __m128i const   _b = nibbles( _mm_loadu_si128( reinterpret_cast<__m128i const*>(hex + 10) ), _bad );
+        __m128i const   _e = _mm_or_si128( _mm_shuffle_epi8( _a, ld128( evenLo ) ), _mm_shuffle_epi8( _b, ld128( evenHi ) ) );
+        __m128i const   _o = _mm_or_si128( _mm_shuffle_epi8( _a, ld128( oddLo ) ), _mm_shuffle_epi8( _b, ld128( oddHi ) ) );
+        __m128i const   _3 = _mm_set1_epi8( 3 );
+        __m128i const   _m = ld128( lane13 );
+        __m128i const   _l = ld128( seatLut );
+
+        s = _mm_and_si128( _mm_shuffle_epi8( _l, _mm_and_si128( _e, _3 ) ), _m );
+        h = _mm_and_si128( _mm_shuffle_epi8( _l, _mm_and_si128( _mm_srli_epi16( _e, 2 ), _3 ) ), _m );
+        d = _mm_and_si128( _mm_shuffle_epi8( _l, _mm_and_si128( _o, _3 ) ), _m );
+        c = _mm_and_si128( _mm_shuffle_epi8( _l, _mm_and_si128( _mm_srli_epi16( _o, 2 ), _3 ) ), _m );
+        return _mm_testz_si128( _bad, _bad );
+    }
+
+    SSE41
+    bool decode_sse41( int* deck, char const* hex )
+    {
+        __m128i s, h, d, c;
+        bool    _chars{seats_sse( hex, s, h, d, c )};
+        store13( deck,      s );
+        store13( deck + 13, h );
+        store13( deck + 26, d );
+        store13( deck + 39, c );
+        return _chars && counts_ok( s, h, d, c );
+    }
+
+    SSE41
+    bool verify_sse41( char const* hex )
+    {
+        __m128i s, h, d, c;
+        return seats_sse( hex, s, h, d, c ) && counts_ok( s, h, d, c );
+    }
+
+    SSE41 inline
+    __m128i ld4( int const* deck ) { return _mm_loadu_si128( reinterpret_cast<__m128i const*>(deck) ); }
+
+    //!> 16 ints -> 16 bytes
+    SSE41 inline
+    __m128i pack16( int const* deck )
+    {
+        return _mm_packus_epi16( _mm_packus_epi32( ld4( deck ),     ld4( deck + 4 ) ),
+                                 _mm_packus_epi32( ld4( deck + 8 ), ld4( deck + 12 ) ) );
+    }
+
+    // 52 ints -> 52 bytes; suits realigned to lane 0 with palignr
+    SSE41
+    void encode_sse41( char* hex, int const* deck )
+    {
+        __m128i const   _v0 = pack16( deck );
+        __m128i const   _v1 = pack16( deck + 16 );
+        __m128i const   _v2 = pack16( deck + 32 );
+        __m128i const   _v3 = _mm_packus_epi16( _mm_packus_epi32( ld4( deck + 48 ), _mm_setzero_si128() ), _mm_setzero_si128() );
+        __m128i const   _3  = _mm_set1_epi8( 3 );
+
+        __m128i const   _s = _mm_and_si128( _v0, _3 );
+        __m128i const   _h = _mm_and_si128( _mm_alignr_epi8( _v1, _v0, 13 ), _3 );
+        __m128i const   _d = _mm_and_si128( _mm_alignr_epi8( _v2, _v1, 10 ), _3 );
+        __m128i const   _c = _mm_and_si128( _mm_alignr_epi8( _v3, _v2, 7 ), _3 );
+        __m128i const   _e = _mm_or_si128( _s, _mm_slli_epi16( _h, 2 ) );
+        __m128i const   _o = _mm_or_si128( _d, _mm_slli_epi16( _c, 2 ) );
+        __m128i const   _l = ld128( hexLut );
+        __m128i const   _lo = _mm_shuffle_epi8( _l, _mm_unpacklo_epi8( _e, _o ) );
+        __m128i const   _hi = _mm_shuffle_epi8( _l, _mm_unpackhi_epi8( _e, _o ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(hex), _lo );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(hex + 10), _mm_alignr_epi8( _hi, _lo, 10 ) );
+    }
+
+//-------------------------------------------------------------------------
+// AVX2 kernels: two records per pass, one per 128-bit lane.
+//-------------------------------------------------------------------------
+
+    AVX2 inline
+    __m256i bcast( signed char const* tbl ) { return _mm256_broadcastsi128_si256( ld128( tbl ) ); }
+
+    AVX2 inline
+    __m256i load2( char const* p0, char const* p1 )
+    {
+        return _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( reinterpret_cast<__m128i const*>(p0) ) ),
+                                        _mm_loadu_si128( reinterpret_cast<__m128i const*>(p1) ), 1 );
+    }
+
+    AVX2 inline
+    __m256i nibbles2( __m256i x, __m256i& bad )
+    {
+        __m256i const _dg  = _mm256_sub_epi8( x, _mm256_set1_epi8( '0' ) );
+        __m256i const _al  = _mm256_sub_epi8( _mm256_or_si256( x, _mm256_set1_epi8( 0x20 ) ), _mm256_set1_epi8( 'a' ) );
+        __m256i const _isd = _mm256_cmpeq_epi8( _mm256_min_epu8( _dg, _mm256_set1_epi8( 9 ) ), _dg );
+        __m256i const _isa = _mm256_cmpeq_epi8( _mm256_min_epu8( _al, _mm256_set1_epi8( 5 ) ), _al );
+        bad = _mm256_or_si256( bad, _mm256_xor_si256( _mm256_or_si256( _isd, _isa ), _mm256_set1_epi8( -1 ) ) );
+        return _mm256_blendv_epi8( _mm256_add_epi8( _al, _mm256_set1_epi8( 10 ) ), _dg, _isd );
+    }
+
+    //!> bit 0: first record valid, bit 1: second record valid
+    AVX2
+    int seats_avx2( char const* h0, char const* h1, __m256i& s, __m256i& h, __m256i& d, __m256i& c )
+    {
+        __m256i         _bad{_mm256_setzero_si256()};
+        __m256i const   _a = nibbles2( load2( h0, h1 ), _bad );
+        __m256i const   _b = nibbles2( load2( h0 + 10, h1 + 10 ), _bad );
+        __m256i const   _e = _mm256_or_si256( _mm256_shuffle_epi8( _a, bcast( evenLo ) ), _mm256_shuffle_epi8( _b, bcast( evenHi ) ) );
+        __m256i const   _o = _mm256_or_si256( _mm256_shuffle_epi8( _a, bcast( oddLo ) ), _mm256_shuffle_epi8( _b, bcast( oddHi ) ) );
+        __m256i const   _3 = _mm256_set1_epi8( 3 );
+        __m256i const   _m = bcast( lane13 );
+        __m256i const   _l = bcast( seatLut );
+
+        s = _mm256_and_si256( _mm256_shuffle_epi8( _l, _mm256_and_si256( _e, _3 ) ), _m );
+        h = _mm256_and_si256( _mm256_shuffle_epi8( _l, _mm256_and_si256( _mm256_srli_epi16( _e, 2 ), _3 ) ), _m );
+        d = _mm256_and_si256( _mm256_shuffle_epi8( _l, _mm256_and_si256( _o, _3 ) ), _m );
+        c = _mm256_and_si256( _mm256_shuffle_epi8( _l, _mm256_and_si256( _mm256_srli_epi16( _o, 2 ), _3 ) ), _m );
+
+        __m256i _ok{_mm256_cmpeq_epi8( _bad, _mm256_setzero_si256() )};
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            __m256i const _k{_mm256_set1_epi8( _seat )};
+            __m256i _n = _mm256_sub_epi8( _mm256_setzero_si256(), _mm256_cmpeq_epi8( s, _k ) );
+            _n = _mm256_sub_epi8( _n, _mm256_cmpeq_epi8( h, _k ) );
+            _n = _mm256_sub_epi8( _n, _mm256_cmpeq_epi8( d, _k ) );
+            _n = _mm256_sub_epi8( _n, _mm256_cmpeq_epi8( c, _k ) );
+            _n = _mm256_sad_epu8( _n, _mm256_setzero_si256() );
+            _n = _mm256_add_epi64( _n, _mm256_shuffle_epi32( _n, 0x4E ) ); // swap qwords within lanes
+            // every qword now holds its lane's total; splat the verdict to all bytes
+            _ok = _mm256_and_si256( _ok, _mm256_cmpeq_epi64( _n, _mm256_set1_epi64x( 13 ) ) );
+        }
+        unsigned const _mask = static_cast<unsigned>(_mm256_movemask_epi8( _ok ));
+        return ((_mask & 0x0000FFFFu) == 0x0000FFFFu ? 1 : 0)
+             | ((_mask & 0xFFFF0000u) == 0xFFFF0000u ? 2 : 0);
+    }
+
+    AVX2
+    int decode2_avx2( int* d0, int* d1, char const* h0, char const* h1 )
+    {
+        __m256i s, h, d, c;
+        int     _ok{seats_avx2( h0, h1, s, h, d, c )};
+        store13( d0,      _mm256_castsi256_si128( s ) );
+        store13( d0 + 13, _mm256_castsi256_si128( h ) );
+        store13( d0 + 26, _mm256_castsi256_si128( d ) );
+        store13( d0 + 39, _mm256_castsi256_si128( c ) );
+        store13( d1,      _mm256_extracti128_si256( s, 1 ) );
+        store13( d1 + 13, _mm256_extracti128_si256( h, 1 ) );
+        store13( d1 + 26, _mm256_extracti128_si256( d, 1 ) );
+        store13( d1 + 39, _mm256_extracti128_si256( c, 1 ) );
+        return _ok;
+    }
+
+    AVX2
+    int verify2_avx2( char const* h0, char const* h1 )
+    {
+        __m256i s, h, d, c;
+        return seats_avx2( h0, h1, s, h, d, c );
+    }
+
+#undef SSE41
+#undef AVX2
+#endif // CODEC_X86
+
+//-------------------------------------------------------------------------
+// dispatch
+//-------------------------------------------------------------------------
+
+    using Decoder = bool (*)( int*, char const* );
+    using Verifier = bool (*)( char const* );
+    using Encoder = void (*)( char*, int const* );
+
+    struct Dispatch
+    {
+        DeckCodec::Kernel   kernel{DeckCodec::Kernel::SCALAR};
+        Decoder             decode{&decode_scalar};
+        Verifier            verify{&verify_scalar};
+        Encoder             encode{&encode_scalar};
+    };
+
+    DeckCodec::Kernel best_kernel()
+    {
+        static DeckCodec::Kernel const  _best([]()
+        {
+#ifdef CODEC_X86
+            __builtin_cpu_init();
+            if ( __builtin_cpu_supports( "avx2" ) ) { return DeckCodec::Kernel::AVX2; }
+            if ( __builtin_cpu_supports( "sse4.1" ) ) { return DeckCodec::Kernel::SSE41; }
+#endif
+            return DeckCodec::Kernel::SCALAR;
+        }());
+        return _best;
+    }
+
+    // by Kernel; AVX2 differs from SSE41 only in the two-record batch loops
+    Dispatch const  dispatches[] =
+    {
+        {DeckCodec::Kernel::SCALAR, &decode_scalar, &verify_scalar, &encode_scalar},
+#ifdef CODEC_X86
+        {DeckCodec::Kernel::SSE41,  &decode_sse41,  &verify_sse41,  &encode_sse41},
+        {DeckCodec::Kernel::AVX2,   &decode_sse41,  &verify_sse41,  &encode_sse41},
+#endif
+    };
+
+    //!> the table in use, the best for the cpu until kernel( Kernel ) swaps it;
+    //!> a function-local static, so it is set on first use from any thread
+    std::atomic<Dispatch const*>& current()
+    {
+        static std::atomic<Dispatch const*>     _current{&dispatches[static_cast<int>(best_kernel())]};
+        return _current;
+    }
+
+    inline Dispatch const& dispatch() { return *current().load( std::memory_order_acquire ); }
+}
+
+    char const                      DeckCodec::hexDigits_[17] = "0123456789ABCDEF";
+    DeckCodec::HexValues const      DeckCodec::hexValues_ = make_hex_values();
+
+    DeckCodec::Kernel /* static */
+    DeckCodec::kernel()
+    {
+        return dispatch().kernel;
+    }
+
+    void /* static */
+    DeckCodec::kernel( Kernel kernel )
+    {
+        current().store( &dispatches[static_cast<int>(std::min( kernel, best_kernel() ))], std::memory_order_release );
+    }
+
+    char const* /* static */
+    DeckCodec::kernel_name( Kernel kernel )
+    {
+        switch ( kernel )
+        {
+        case Kernel::SCALAR: return "scalar";
+        case Kernel::SSE41 : return "sse4.1";
+        case Kernel::AVX2  : return "avx2";
+        default: return "?";
+        }
+    }
+
+    bool /* static */
+    DeckCodec::decode_hex( int* deck, char const* hex )
+    {
+        return dispatch().decode( deck, hex );
+    }
+
+    void /* static */
+    DeckCodec::encode_hex( char* hex, int const* deck )
+    {
+        dispatch().encode( hex, deck );
+    }
+
+    bool /* static */
+    DeckCodec::verify_hex( char const* hex )
+    {
+        return dispatch().verify( hex );
+    }
+
+    std::size_t /* static */
+    DeckCodec::decode_hex( Deck* decks, char const* buf, std::size_t count, std::size_t stride, bool* ok )
+    {
+        Dispatch const&     _dispatch(dispatch()); // one kernel for the whole batch
+        std::size_t     _valid{0};
+        std::size_t     _ndx{0};
+#ifdef CODEC_X86
+        if ( _dispatch.kernel == Kernel::AVX2 )
+        {
+            for ( ; _ndx + 1 < count; _ndx += 2, buf += 2 * stride )
+            {
+                int _ok{decode2_avx2( decks[_ndx].begin(), decks[_ndx + 1].begin(), buf, buf + stride )};
+                if ( ok )
+                {
+                    ok[_ndx]     = _ok & 1;
+                    ok[_ndx + 1] = _ok & 2;
+                }
+                _valid += (_ok & 1) + (_ok >> 1);
+            }
+        }
+#endif
+        for ( ; _ndx < count; ++_ndx, buf += stride )
+        {
+            bool    _ok{_dispatch.decode( decks[_ndx].begin(), buf )};
+            if ( ok ) { ok[_ndx] = _ok; }
+            _valid += _ok;
+        }
+        return _valid;
+    }
+
+    std::size_t /* static */
+    DeckCodec::verify_hex( bool* ok, char const* buf, std::size_t count, std::size_t stride )
+    {
+        Dispatch const&     _dispatch(dispatch());
+        std::size_t     _valid{0};
+        std::size_t     _ndx{0};
+#ifdef CODEC_X86
+        if ( _dispatch.kernel == Kernel::AVX2 )
+        {
+            for ( ; _ndx + 1 < count; _ndx += 2, buf += 2 * stride )
+            {
+                int _ok{verify2_avx2( buf, buf + stride )};
+                if ( ok )
+                {
+                    ok[_ndx]     = _ok & 1;
+                    ok[_ndx + 1] = _ok & 2;
+                }
+                _valid += (_ok & 1) + (_ok >> 1);
+            }
+        }
+#endif
+        for ( ; _ndx < count; ++_ndx, buf += stride )
+        {
+            bool    _ok{_dispatch.verify( buf )};
+            if ( ok ) { ok[_ndx] = _ok; }
+            _valid += _ok;
+        }
+        return _valid;
+    }
+
+    void /* static */
+    DeckCodec::encode_hex( char* buf, Deck const* decks, std::size_t count, std::size_t stride, char term )
+    {
+        Dispatch const&     _dispatch(dispatch());
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx, buf += stride )
+        {
+            _dispatch.encode( buf, decks[_ndx].begin() );
+            if ( stride > HEXLEN ) { buf[HEXLEN] = term; }
+        }
+    }
+
+    std::size_t /* static */
+    DeckCodec::decode_lines( Deck* decks, std::size_t max, char const* buf, std::size_t len,
+                             Deck::Format fmt, bool* ok, std::size_t* used )
+    {
+        Dispatch const&     _dispatch(dispatch());
+        char const* _ptr{buf};
+        char const* _end{buf + len};
+        std::size_t _ndx{0};
+
+        for ( ; _ndx < max && _ptr < _end; ++_ndx )
+        {
+            char const* _eol = static_cast<char const*>(::memchr( _ptr, '\n', _end - _ptr ));
+            if ( !_eol ) { _eol = _end; }
+            bool        _ok{false};
+            decks[_ndx] = Deck();
+            switch ( fmt )
+            {
+            case Deck::Format::HEX:
+                _ok = _eol - _ptr >= HEXLEN && _dispatch.decode( decks[_ndx].begin(), _ptr );
+                break;
+            case Deck::Format::BHG:
+                _ok = _eol - _ptr >= 52 && decks[_ndx].load_bhg( _ptr );
+                break;
+            // the text loaders stop at end of line
+            case Deck::Format::LIN: _ok = decks[_ndx].load_lin_s( _ptr ); break;
+            case Deck::Format::PBN: _ok = decks[_ndx].load_pbn_s( _ptr ); break;
+            }
+            if ( ok ) { ok[_ndx] = _ok; }
+            _ptr = _eol < _end ? _eol + 1 : _end;
+        }
+        if ( used ) { *used = _ptr - buf; }
+        return _ndx;
+    }
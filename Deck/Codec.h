@@ -0,0 +1,73 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_CODEC_H
+#define BRIDGE_CODEC_H
+
+#include "Deck.h"
+
+#include <cstddef>
+
+    /**
+     * @class DeckCodec
+     * @brief Table driven and SIMD backends for the Deck string formats.
+     * Single record entry points are what Deck::load_hex() and friends
+     * call. Batch entry points take N records from one contiguous buffer:
+     * - fixed width (hex): record i starts at buf + i * stride.
+     * - variable width (any Format): newline separated lines.
+     * The kernel (SCALAR, SSE41, AVX2) is picked from the cpu flags on first
+     * use and can be swapped while other threads decode. Only the hex entry
+     * points have vector kernels; the other formats are table driven scalar
+     * code whatever the kernel.
+     */
+    class DeckCodec
+    {
+    public:
+        enum class Kernel : int { SCALAR, SSE41, AVX2 };
+
+        static Kernel kernel();
+        static void   kernel( Kernel ); //!< force a kernel (benchmarks), clamped to cpu
+        static char const* kernel_name( Kernel );
+
+        //!> '0'..'9', 'A'..'F' for 0..15
+        static char hex_digit( unsigned nibble ) { return hexDigits_[nibble & 15]; }
+        //!> 0..15 for a hex digit in either case, -1 if not one
+        static int hex_value( char c ) { return hexValues_.at[static_cast<unsigned char>(c)]; }
+
+        //!> decode 26 hex chars into a 52-array; false if not a valid deal
+        static bool decode_hex( int* deck, char const* hex );
+        //!> encode a 52-array into 26 hex chars (no terminator)
+        static void encode_hex( char* hex, int const* deck );
+        //!> valid hex digits, and 13 cards per seat
+        static bool verify_hex( char const* hex );
+
+        //!> returns the number of valid deals; ok[i] (if given) per record
+        static std::size_t decode_hex( Deck* decks, char const* buf, std::size_t count, std::size_t stride, bool* ok = nullptr );
+        static std::size_t verify_hex( bool* ok, char const* buf, std::size_t count, std::size_t stride );
+        //!> each record is 26 chars, followed by 'term' if stride > 26
+        static void encode_hex( char* buf, Deck const* decks, std::size_t count, std::size_t stride, char term = '\n' );
+
+        /**
+         * Newline separated records, any Format.
+         * Decodes up to 'max' lines, returns the number of lines consumed;
+         * 'used' (if given) receives the number of bytes consumed.
+         */
+        static std::size_t decode_lines( Deck* decks, std::size_t max, char const* buf, std::size_t len,
+                                         Deck::Format fmt, bool* ok = nullptr, std::size_t* used = nullptr );
+
+        //!> 256-entry lookup, -1 for "not a hex digit"
+        struct HexValues
+        {
+            signed char at[256];
+        };
+
+    private:
+        static char const       hexDigits_[17];
+        static HexValues const  hexValues_;
+    };
+
+#endif // BRIDGE_CODEC_H
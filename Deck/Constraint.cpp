@@ -0,0 +1,332 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Constraint.h"
+#include "Generator.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <ctype.h>
+
+namespace
+{
+    enum { BLOCK = 4096 }; //!< boards per unit of work in search
+
+    using Shapes = std::bitset<14 * 14 * 14>;
+
+    //!> every (s, h, d) that leaves 0..13 clubs
+    template<typename Pred>
+    Shapes shapes_where( Pred&& pred )
+    {
+        Shapes  _shapes;
+        for ( int _s{0}; _s <= 13; ++_s )
+            for ( int _h{0}; _s + _h <= 13; ++_h )
+                for ( int _d{0}; _s + _h + _d <= 13; ++_d )
+                {
+                    if ( pred( std::array<int, 4>{{_s, _h, _d, 13 - _s - _h - _d}} ) )
+                    {
+                        _shapes.set( 196 * _s + 14 * _h + _d );
+                    }
+                }
+        return _shapes;
+    }
+
+    //!> lengths sorted longest first, as a number: 5431
+    int pattern( std::array<int, 4> lengths )
+    {
+        std::sort( lengths.begin(), lengths.end(), []( int a, int b ) { return a > b; } );
+        return ((lengths[0] * 10 + lengths[1]) * 10 + lengths[2]) * 10 + lengths[3];
+    }
+
+    //!> N, N-M, N+ or -M, within 0..max
+    bool to_range( std::string const& text, int max, int& lo, int& hi )
+    {
+        char const* _ptr{text.c_str()};
+        char*       _end;
+        lo = 0;
+        hi = max;
+        if ( *_ptr == '-' )
+        {
+            hi = static_cast<int>(std::strtol( _ptr + 1, &_end, 10 ));
+            if ( _end == _ptr + 1 ) { return false; }
+        }
+        else
+        {
+            lo = static_cast<int>(std::strtol( _ptr, &_end, 10 ));
+            if ( _end == _ptr ) { return false; }
+            if ( *_end == '+' ) { ++_end; }
+            else if ( *_end == '-' )
+            {
+                _ptr = _end + 1;
+                hi = static_cast<int>(std::strtol( _ptr, &_end, 10 ));
+                if ( _end == _ptr ) { return false; }
+            }
+            else { hi = lo; }
+        }
+        return *_end == '\0' && lo >= 0 && lo <= hi && hi <= max;
+    }
+
+    //!> SA, HT, C2 ... (or H10) to a Deck slot, -1 if invalid
+    int to_slot( std::string const& card )
+    {
+        static char const   suits[] = "SHDC";
+        static char const   ranks[] = "AKQJT98765432";
+        if ( card.size() < 2 ) { return -1; }
+        char const* _suit = std::strchr( suits, ::toupper( card[0] ) );
+        char const  _rank = card.substr( 1 ) == "10" ? 'T' : card.size() == 2 ? ::toupper( card[1] ) : 0;
+        char const* _where = _rank ? std::strchr( ranks, _rank ) : nullptr;
+        if ( !_suit || !_where ) { return -1; }
+        return 13 * static_cast<int>(_suit - suits) + static_cast<int>(_where - ranks);
+    }
+
+    std::vector<std::string> split( std::string const& text, char sep )
+    {
+        std::vector<std::string>    _parts;
+        std::istringstream          _in(text);
+        for ( std::string _part; std::getline( _in, _part, sep ); ) { _parts.push_back( _part ); }
+        return _parts;
+    }
+
+    int suit_of( std::string const& key )
+    {
+        return key.size() == 1 && std::strchr( "shdc", key[0] ) ? static_cast<int>(std::strchr( "shdc", key[0] ) - "shdc") : -1;
+    }
+}
+
+    DealFilter::DealFilter(char const* spec)
+    {
+        Shapes const    _valid{shapes_where( []( std::array<int, 4> const& ) { return true; } )};
+        for ( auto& _seat : seats_ ) { _seat.shapes = _valid; }
+        if ( !parse_( spec ) ) { return; }
+
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            Seat const& _s(seats_[_seat - 1]);
+            if ( _s.shapes.none() || (_s.need & _s.deny) || _s.hcp_lo > _s.hcp_hi )
+            {
+                fail_( std::string("no hand satisfies seat ") + "WNES"[_seat - 1] );
+                return;
+            }
+        }
+        for ( int _ndx{0}; _ndx < 4; ++_ndx )
+        {
+            for ( int _other{_ndx + 1}; _other < 4; ++_other )
+            {
+                if ( seats_[_ndx].need & seats_[_other].need ) { fail_( "a card is required in two hands" ); return; }
+            }
+        }
+    }
+
+    bool
+    DealFilter::fail_( std::string const& why )
+    {
+        error_ = why;
+        active_.clear();
+        sided_.clear();
+        return false;
+    }
+
+    bool
+    DealFilter::parse_( char const* spec )
+    {
+        int     _clause{0};
+        for ( auto const& _text : split( spec ? spec : "", ';' ) )
+        {
+            ++_clause;
+            std::string::size_type const    _colon{_text.find( ':' )};
+            std::istringstream              _head(_text.substr( 0, _colon ));
+            std::string                     _who;
+            _head >> _who;
+            if ( _colon == std::string::npos && _who.empty() ) { continue; } // empty clause
+            std::transform( _who.begin(), _who.end(), _who.begin(), ::toupper );
+
+            int     _seat{0};
+            int     _side{-1};
+            if ( _who.size() == 1 && std::strchr( "WNES", _who[0] ) ) { _seat = static_cast<int>(std::strchr( "WNES", _who[0] ) - "WNES") + 1; }
+            else if ( _who == "NS" || _who == "SN" ) { _side = 0; }
+            else if ( _who == "EW" || _who == "WE" ) { _side = 1; }
+            if ( _colon == std::string::npos || (_seat == 0 && _side < 0) )
+            {
+                return fail_( "clause " + std::to_string( _clause ) + ": expected W:, N:, E:, S:, NS: or EW:" );
+            }
+
+            std::istringstream  _terms(_text.substr( _colon + 1 ));
+            for ( std::string _term; _terms >> _term; )
+            {
+                std::string::size_type const    _eq{_term.find( '=' )};
+                std::string     _key{_term.substr( 0, _eq )};
+                std::string     _value{_eq == std::string::npos ? "" : _term.substr( _eq + 1 )};
+                std::transform( _key.begin(), _key.end(), _key.begin(), ::tolower );
+                std::string const   _bad{"clause " + std::to_string( _clause ) + ": bad term '" + _term + "'"};
+                int     _lo, _hi;
+
+                if ( (_key == "bal" || _key == "unbal") && _eq == std::string::npos ) { _value = _key; _key = "shape"; }
+                else if ( _eq == std::string::npos ) { return fail_( _bad ); }
+
+                if ( _side >= 0 )
+                {
+                    Side&       _s(sides_[_side]);
+                    int const   _suit{suit_of( _key )};
+                    if ( _key == "hcp" && to_range( _value, 40, _lo, _hi ) )
+                    {
+                        _s.hcp_lo = std::max( _s.hcp_lo, _lo );
+                        _s.hcp_hi = std::min( _s.hcp_hi, _hi );
+                    }
+                    else if ( _suit >= 0 && to_range( _value, 13, _lo, _hi ) )
+                    {
+                        _s.len_lo[_suit] = std::max( _s.len_lo[_suit], _lo );
+                        _s.len_hi[_suit] = std::min( _s.len_hi[_suit], _hi );
+                    }
+                    else { return fail_( _bad ); }
+                    if ( std::find( sided_.begin(), sided_.end(), _side ) == sided_.end() ) { sided_.push_back( _side ); }
+                    continue;
+                }
+
+                Seat&       _s(seats_[_seat - 1]);
+                int const   _suit{suit_of( _key )};
+                if ( _key == "hcp" && to_range( _value, 37, _lo, _hi ) )
+                {
+                    _s.hcp_lo = std::max( _s.hcp_lo, _lo );
+                    _s.hcp_hi = std::min( _s.hcp_hi, _hi );
+                }
+                else if ( _suit >= 0 && to_range( _value, 13, _lo, _hi ) )
+                {
+                    _s.shapes &= shapes_where( [=]( std::array<int, 4> const& len )
+                    {
+                        return len[_suit] >= _lo && len[_suit] <= _hi;
+                    });
+                }
+                else if ( _key == "shape" )
+                {
+                    std::vector<int>    _patterns;
+                    bool                _unbal{false};
+                    for ( auto const& _item : split( _value, ',' ) )
+                    {
+                        if ( _item == "bal" ) { _patterns.insert( _patterns.end(), {4333, 4432, 5332} ); continue; }
+                        if ( _item == "unbal" ) { _unbal = true; continue; }
+                        if ( _item.size() != 4 || !std::all_of( _item.begin(), _item.end(), ::isdigit ) ) { return fail_( _bad ); }
+                        std::array<int, 4>  _len{{_item[0] - '0', _item[1] - '0', _item[2] - '0', _item[3] - '0'}};
+                        if ( _len[0] + _len[1] + _len[2] + _len[3] != 13 ) { return fail_( _bad ); }
+                        _patterns.push_back( pattern( _len ) );
+                    }
+                    if ( _patterns.empty() && !_unbal ) { return fail_( _bad ); }
+                    _s.shapes &= shapes_where( [&]( std::array<int, 4> const& len )
+                    {
+                        int const   _pattern{pattern( len )};
+                        return std::find( _patterns.begin(), _patterns.end(), _pattern ) != _patterns.end()
+                            || (_unbal && _pattern != 4333 && _pattern != 4432 && _pattern != 5332);
+                    });
+                }
+                else if ( _key == "has" || _key == "not" )
+                {
+                    Bitboard::Mask& _mask(_key == "has" ? _s.need : _s.deny);
+                    for ( auto const& _card : split( _value, ',' ) )
+                    {
+                        int const   _slot{to_slot( _card )};
+                        if ( _slot < 0 ) { return fail_( _bad ); }
+                        _mask |= Bitboard::card( _slot );
+                    }
+                }
+                else { return fail_( _bad ); }
+                if ( std::find( active_.begin(), active_.end(), _seat ) == active_.end() ) { active_.push_back( _seat ); }
+            }
+        }
+        return true;
+    }
+
+    bool
+    DealFilter::operator()( Bitboard const& deal ) const
+    {
+        using Mask = Bitboard::Mask;
+        constexpr Mask  SUIT{Bitboard::SUIT};
+
+        // shapes first: three popcounts and a table lookup per seat
+        for ( int _seat : active_ )
+        {
+            Mask const  _hand{deal.hand( _seat )};
+            int const   _ndx{196 * Bitboard::popcount( _hand & SUIT ) + 14 * Bitboard::popcount( _hand & SUIT << 16 )
+                           + Bitboard::popcount( _hand & SUIT << 32 )};
+            if ( !seats_[_seat - 1].shapes[_ndx] ) { return false; }
+        }
+        for ( int _seat : active_ )
+        {
+            Seat const& _s(seats_[_seat - 1]);
+            Mask const  _hand{deal.hand( _seat )};
+            if ( (_hand & _s.need) != _s.need || (_hand & _s.deny) ) { return false; }
+        }
+        for ( int _seat : active_ )
+        {
+            Seat const& _s(seats_[_seat - 1]);
+            int const   _hcp{deal.hcp( _seat )};
+            if ( _hcp < _s.hcp_lo || _hcp > _s.hcp_hi ) { return false; }
+        }
+        for ( int _side : sided_ )
+        {
+            Side const& _s(sides_[_side]);
+            Mask const  _hands{_side == 0 ? deal.hand( 2 ) | deal.hand( 4 ) : deal.hand( 1 ) | deal.hand( 3 )};
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                int const   _len{Bitboard::popcount( _hands & SUIT << (16 * _suit) )};
+                if ( _len < _s.len_lo[_suit] || _len > _s.len_hi[_suit] ) { return false; }
+            }
+            int const   _hcp{4 * Bitboard::popcount( _hands & Bitboard::ACES )   + 3 * Bitboard::popcount( _hands & Bitboard::KINGS )
+                           + 2 * Bitboard::popcount( _hands & Bitboard::QUEENS ) +     Bitboard::popcount( _hands & Bitboard::JACKS )};
+            if ( _hcp < _s.hcp_lo || _hcp > _s.hcp_hi ) { return false; }
+        }
+        return true;
+    }
+
+    std::uint64_t
+    DealFilter::search( DealGenerator const& gen, std::uint64_t first, std::size_t want,
+                        std::vector<Match>& out, unsigned threads, std::uint64_t limit ) const
+    {
+        if ( want == 0 || !*this ) { return 0; }
+        if ( threads == 0 ) { threads = std::max( 1u, std::thread::hardware_concurrency() ); }
+
+        // rounds of blocks, taken by any thread, merged in board order
+        std::vector<std::vector<Match>> _hits(4 * static_cast<std::size_t>(threads));
+        std::uint64_t   _scanned{0};
+        std::uint64_t   _last{0};
+        std::size_t     _found{0};
+
+        while ( _found < want && (limit == 0 || _scanned < limit) )
+        {
+            std::uint64_t   _round{BLOCK * static_cast<std::uint64_t>(_hits.size())};
+            if ( limit ) { _round = std::min( _round, limit - _scanned ); }
+            std::size_t const           _blocks((_round + BLOCK - 1) / BLOCK);
+            std::uint64_t const         _begin{first + _scanned};
+
+            Utility::Parallel::each( _blocks, threads, [&]( Utility::Parallel::Next& next )
+            {
+                Bitboard    _deal;
+                for ( std::size_t _ndx; next( _ndx ); )
+                {
+                    std::uint64_t const _end{std::min( _begin + BLOCK * (_ndx + 1), _begin + _round )};
+                    _hits[_ndx].clear();
+                    for ( std::uint64_t _board{_begin + BLOCK * _ndx}; _board < _end; ++_board )
+                    {
+                        if ( (*this)( gen.deal( _deal, _board ) ) ) { _hits[_ndx].push_back( Match{_board, _deal} ); }
+                    }
+                }
+            });
+
+            for ( std::size_t _ndx{0}; _ndx < _blocks && _found < want; ++_ndx )
+            {
+                for ( auto const& _match : _hits[_ndx] )
+                {
+                    out.push_back( _match );
+                    _last = _match.board;
+                    if ( ++_found == want ) { break; }
+                }
+            }
+            _scanned += _round;
+        }
+        return _found == want ? _last - first + 1 : _scanned;
+    }
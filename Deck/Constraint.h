@@ -0,0 +1,99 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_CONSTRAINT_H
+#define BRIDGE_CONSTRAINT_H
+
+#include "Bitboard.h"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class DealGenerator;
+
+    /**
+     * @class DealFilter
+     * @brief Hand constraints, compiled once into tables and masks.
+     * A spec is a list of clauses separated by ';', each a seat (W N E S)
+     * or a side (NS EW), a ':' and space separated terms:
+     *   hcp=R          high card points
+     *   s=R h=R d=R c=R    suit lengths
+     *   shape=5431,4432    patterns in any suit order; 'bal' for 4333,4432,5332,
+     *                  'unbal' for any other
+     *   bal, unbal     same as shape=bal, shape=unbal
+     *   has=SA,HK      cards held;  not=SQ  cards not held
+     * where a range R is N, N-M, N+ or -M. A side takes hcp and suit
+     * lengths, summed over both hands. All terms must hold, e.g.
+     *   "N: hcp=5-10 s=6 h=-3; S: hcp=12+"
+     *
+     * The suit length and shape terms of a seat are folded into a single
+     * table over (spades, hearts, diamonds), so the shape test is three
+     * popcounts and a lookup. Shapes are tested for every seat before any
+     * card masks or points, so most rejections are cheap.
+     */
+    class DealFilter
+    {
+    public:
+        struct Match
+        {
+            std::uint64_t   board;  //!< generator board number
+            Bitboard        deal;
+        };
+
+        ~DealFilter() noexcept = default;
+        explicit
+        DealFilter(char const* spec);
+
+        explicit operator bool() const { return error_.empty(); }
+        std::string const& error() const { return error_; }
+
+        bool operator()( Bitboard const& ) const;
+
+        /**
+         * Up to 'want' matching deals from generator boards first, first+1, ...
+         * appended to 'out', scanning no more than 'limit' boards (0: no limit).
+         * Results are the same for any number of threads.
+         * @return the number of boards scanned up to the last match (all of
+         * them when fewer than 'want' were found)
+         */
+        std::uint64_t search( DealGenerator const& gen, std::uint64_t first, std::size_t want,
+                              std::vector<Match>& out, unsigned threads = 0,
+                              std::uint64_t limit = 0 ) const;
+
+    private:
+        using Shapes = std::bitset<14 * 14 * 14>; //!< index 196 * s + 14 * h + d
+
+        struct Seat
+        {
+            Shapes          shapes;
+            Bitboard::Mask  need{0};
+            Bitboard::Mask  deny{0};
+            int             hcp_lo{0};
+            int             hcp_hi{40};
+        };
+        struct Side
+        {
+            std::array<int, 4>  len_lo{{0, 0, 0, 0}};
+            std::array<int, 4>  len_hi{{26, 26, 26, 26}};
+            int                 hcp_lo{0};
+            int                 hcp_hi{40};
+        };
+
+        std::array<Seat, 4>     seats_;  //!< W N E S
+        std::array<Side, 2>     sides_;  //!< NS EW
+        std::vector<int>        active_; //!< seats with any constraint
+        std::vector<int>        sided_;  //!< sides with any constraint
+        std::string             error_;
+
+        bool parse_( char const* spec );
+        bool fail_( std::string const& );
+    };
+
+#endif // BRIDGE_CONSTRAINT_H
@@ -0,0 +1,206 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Converter.h"
+#include "ChunkPool.h"
+#include "Codec.h"
+#include "Parallel.h"
+#include "StrFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <errno.h>
+
+namespace
+{
+    enum { MAXLINE = 128 }; //!< longest output line (PBN)
+
+    struct Chunk
+    {
+        char const*     begin;
+        char const*     end;
+        std::size_t     line{0};   //!< lines before this chunk
+        std::size_t     lines{0};
+        std::size_t     deals{0};
+        std::size_t     errors{0};
+        std::size_t     first_error{0};
+        std::string     out;
+
+        Chunk(char const* b, char const* e) : begin(b), end(e) {}
+    };
+
+    void convert_chunk( Chunk& chunk, Converter::Options const& opts )
+    {
+        std::size_t _lineno{chunk.line};
+        chunk.out.reserve( (chunk.end - chunk.begin) * 3 + MAXLINE );
+
+        for ( char const* _ptr{chunk.begin}; _ptr < chunk.end; )
+        {
+            char const* _eol = static_cast<char const*>(::memchr( _ptr, '\n', chunk.end - _ptr ));
+            if ( !_eol ) { _eol = chunk.end; }
+            ++_lineno;
+
+            std::size_t const   _size{chunk.out.size()};
+            chunk.out.resize( _size + MAXLINE );
+            char*   _out{&chunk.out[_size]};
+            char*   _end{Converter::convert_line( _out, MAXLINE, _ptr, _eol, opts, _lineno )};
+            if ( _end )
+            {
+                *_end++ = '\n';
+                chunk.out.resize( _size + (_end - _out) );
+                ++chunk.deals;
+            }
+            else
+            {
+                chunk.out.resize( _size );
+                if ( _eol > _ptr && !(_eol - _ptr == 1 && *_ptr == '\r') ) // blank lines are not errors
+                {
+                    if ( chunk.errors++ == 0 ) { chunk.first_error = _lineno; }
+                }
+            }
+            _ptr = _eol + 1;
+        }
+        chunk.lines = _lineno - chunk.line;
+    }
+
+    // dealer: seats WNES 1..4; LIN digits 1..4 are SWNE
+    int lin_dealer( char digit ) { return digit > '0' && digit < '5' ? (digit - '1' + 3) % 4 + 1 : 0; }
+    int pbn_dealer( char seat )
+    {
+        switch ( seat )
+        {
+        case 'W': case 'w': return 1;
+        case 'N': case 'n': return 2;
+        case 'E': case 'e': return 3;
+        case 'S': case 's': return 4;
+        default: return 0;
+        }
+    }
+}
+
+    bool /* static */
+    Converter::detect( Deck::Format& fmt, char const* line, char const* eol )
+    {
+        std::size_t const   _len(eol - line);
+        if ( _len >= 26 && std::all_of( line, line + 26, []( char c ) { return ::isxdigit( c ); } ) )
+        {
+            fmt = Deck::Format::HEX;
+        }
+        else if ( _len > 0 && ::isdigit( *line ) ) { fmt = Deck::Format::LIN; }
+        else if ( _len > 1 && line[1] == ':' )     { fmt = Deck::Format::PBN; }
+        else if ( _len >= 52 && ::isalpha( *line ) ) { fmt = Deck::Format::BHG; }
+        else { return false; }
+        return true;
+    }
+
+    char* /* static */
+    Converter::convert_line( char* out, std::size_t len, char const* line, char const* eol,
+                             Options const& opts, std::size_t lineno )
+    {
+        Deck            _deck;
+        int             _dealer{0};
+        std::size_t     _len(eol - line);
+
+        if ( _len > 0 && line[_len - 1] == '\r' ) { --_len; }
+        if ( _len == 0 ) { return nullptr; }
+
+        switch ( opts.from )
+        {
+        case Deck::Format::HEX:
+            if ( _len < 26 || !_deck.load_hex( line ) ) { return nullptr; }
+            if ( _len > 27 && line[26] == '-' && ::isxdigit( line[27] ) )
+            {
+                int const   _dv{::isdigit( line[27] ) ? line[27] - '0' : (line[27] | 0x20) - 'a' + 10};
+                _dealer = _dv % 4 + 1;
+            }
+            break;
+        case Deck::Format::LIN:
+            if ( !_deck.load_lin_s( line ) ) { return nullptr; }
+            _dealer = lin_dealer( *line );
+            break;
+        case Deck::Format::PBN:
+            if ( !_deck.load_pbn_s( line ) ) { return nullptr; }
+            _dealer = pbn_dealer( *line );
+            break;
+        case Deck::Format::BHG:
+            if ( _len < 52 || !_deck.load_bhg( line ) ) { return nullptr; }
+            break;
+        }
+        if ( _deck.count( 1 ) != 13 || _deck.count( 2 ) != 13
+          || _deck.count( 3 ) != 13 || _deck.count( 4 ) != 13 ) { return nullptr; }
+
+        if ( _dealer == 0 ) { _dealer = static_cast<int>((opts.dealer - 1 + lineno - 1) % 4) + 1; }
+
+        switch ( opts.to )
+        {
+        case Deck::Format::HEX: return _deck.store_hex( out, len );
+        case Deck::Format::LIN: return _deck.store_lin_s( out, len, _dealer );
+        case Deck::Format::PBN: return _deck.store_pbn_s( out, len, _dealer );
+        case Deck::Format::BHG: return _deck.store_bhg( out, len, 2 );
+        default: return nullptr;
+        }
+    }
+
+    Converter::Stats /* static */
+    Converter::convert( char const* buf, std::size_t len, std::FILE* out, Options const& opts )
+    {
+        Stats       _stats;
+        std::size_t _size{std::max<std::size_t>( opts.chunk, 4096 )};
+
+        std::vector<Chunk>  _chunks(ChunkPool::split<Chunk>( buf, len, _size ));
+        unsigned const      _threads{Utility::Parallel::threads( opts.threads, _chunks.size() )};
+        if ( _chunks.empty() ) { return _stats; }
+
+        //!> pass 1: line numbers at chunk starts (for dealer cycling and errors)
+        Utility::Parallel::each( _chunks.size(), _threads, [&]( Utility::Parallel::Next& next )
+        {
+            for ( std::size_t _ndx; next( _ndx ); )
+            {
+                Chunk&  _chunk(_chunks[_ndx]);
+                _chunk.lines = std::count( _chunk.begin, _chunk.end, '\n' )
+                             + (_chunk.end[-1] != '\n'); // unterminated last line
+            }
+        });
+        for ( std::size_t _ndx{1}; _ndx < _chunks.size(); ++_ndx )
+        {
+            _chunks[_ndx].line = _chunks[_ndx - 1].line + _chunks[_ndx - 1].lines;
+        }
+
+        //!> pass 2: convert in the pool, written in order
+        ChunkPool::run( _chunks.size(), _threads, [&]( std::size_t ndx ) { convert_chunk( _chunks[ndx], opts ); },
+        [&]( std::size_t ndx )
+        {
+            Chunk&  _chunk(_chunks[ndx]);
+            if ( !_stats.io_error && !_chunk.out.empty()
+              && std::fwrite( _chunk.out.data(), 1, _chunk.out.size(), out ) != _chunk.out.size() )
+            {
+                _stats.io_error = errno;
+            }
+            _stats.lines  += _chunk.lines;
+            _stats.deals  += _chunk.deals;
+            if ( _chunk.errors && _stats.errors == 0 ) { _stats.first_error = _chunk.first_error; }
+            _stats.errors += _chunk.errors;
+            std::string().swap( _chunk.out );
+        });
+        if ( !_stats.io_error && std::fflush( out ) != 0 ) { _stats.io_error = errno; }
+        return _stats;
+    }
+
+    Converter::Stats /* static */
+    Converter::convert( char const* file, std::FILE* out, Options const& opts )
+    {
+        Utility::StrFile    _file(file);
+        if ( !_file )
+        {
+            Stats   _stats;
+            _stats.io_error = _file.error();
+            return _stats;
+        }
+        return convert( _file.get(), _file.size(), out, opts );
+    }
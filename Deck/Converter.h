@@ -0,0 +1,61 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_CONVERTER_H
+#define BRIDGE_CONVERTER_H
+
+#include "Deck.h"
+
+#include <cstddef>
+#include <cstdio>
+
+    /**
+     * @class Converter
+     * @brief Bulk deal format conversion, one deal per line.
+     * The input is split into chunks at line boundaries, chunks are
+     * converted on a pool of threads, and the output is written in input
+     * order, one fwrite() per chunk. Only a bounded window of converted
+     * chunks is held in memory at any time.
+     * Dealer (needed for PBN and LIN output) is taken from the input when
+     * it carries one (PBN first seat, LIN digit, hex "-d" suffix) and
+     * otherwise cycles from Options::dealer by line number, as ToPbn does.
+     */
+    class Converter
+    {
+    public:
+        struct Options
+        {
+            Deck::Format    from{Deck::Format::HEX};
+            Deck::Format    to{Deck::Format::PBN};
+            int             dealer{2};      //!< first dealer (WNES 1..4)
+            unsigned        threads{0};     //!< 0: hardware concurrency
+            std::size_t     chunk{1 << 22}; //!< bytes per chunk (approximate)
+        };
+
+        struct Stats
+        {
+            std::size_t     lines{0};
+            std::size_t     deals{0};
+            std::size_t     errors{0};
+            std::size_t     first_error{0}; //!< line number, 1-based
+            int             io_error{0};    //!< errno, if any
+        };
+
+        //!> convert a buffer (e.g. a mapped file) to the stream
+        static Stats convert( char const* buf, std::size_t len, std::FILE* out, Options const& );
+        //!> convert a file, mapped with Utility::StrFile
+        static Stats convert( char const* file, std::FILE* out, Options const& );
+
+        //!> one line, no terminator; returns the end of the output, or nullptr on error
+        static char* convert_line( char* out, std::size_t len, char const* line, char const* eol,
+                                   Options const&, std::size_t lineno );
+
+        //!> best guess from one line, as SeeFmt does
+        static bool detect( Deck::Format&, char const* line, char const* eol );
+    };
+
+#endif // BRIDGE_CONVERTER_H
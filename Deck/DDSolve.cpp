@@ -0,0 +1,317 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "Solver.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * DDSolve: double dummy results for hex deals, one per line.
+     *   DDSolve [-d W|N|E|S -s S|H|D|C|N] [-j threads] [-b] [file]
+     * With a declarer and strain, each line is the deal and the tricks for
+     * that contract. Otherwise it is the deal and the full table, a group
+     * per strain (S H D C N) of one hex digit per declarer (N S E W), e.g.
+     *   <deal>  8855 9944 4499 5588 7766
+     * -b times the solve and reports deals/sec instead, then checks the
+     * solver against exhaustive search on random endings of a few cards.
+     * With no file, STDIN is read.
+     */
+
+namespace
+{
+    char const  seats[] = "WNES";
+    char const  strains[] = "SHDCN";
+    int const   order[] = {2, 4, 3, 1}; // N S E W
+
+    struct Options
+    {
+        int         declarer{0};
+        int         strain{-1};
+        unsigned    threads{0};
+        bool        bench{false};
+    };
+
+    /**
+     * Plain alpha-beta for small endings, the check on DDSolver: every
+     * legal card at every turn, with no equivalent cards, quick tricks or
+     * winning ranks. Bounds are kept for exact positions at the start of a
+     * trick only. Hands are W N E S, as in the solver.
+     */
+    class Exhaustive
+    {
+    public:
+        using Mask = Bitboard::Mask;
+
+        Exhaustive(Bitboard const& deal, int strain)
+        : trump_(strain)
+        {
+            for ( int _seat{1}; _seat <= 4; ++_seat ) { hands_[_seat - 1] = deal.hand( _seat ); }
+        }
+
+        //!> North-South tricks from here, 'leader' a hand index
+        int tricks( int leader ) { return search_( leader, -1, 14 ); }
+
+    private:
+        using Key = std::array<Mask, 5>;    //!< hands and leader
+        struct Bounds
+        {
+            int lb;
+            int ub;
+        };
+
+        std::array<Mask, 4>     hands_;
+        int                     trump_;
+        std::map<Key, Bounds>   seen_;
+
+        // tricks to come, exact if strictly inside (lo, hi), else a bound
+        int search_( int leader, int lo, int hi )
+        {
+            if ( !hands_[leader] ) { return 0; }
+            Key const   _key{{hands_[0], hands_[1], hands_[2], hands_[3], Mask(leader)}};
+            Bounds&     _bounds(seen_.emplace( _key, Bounds{0, Bitboard::popcount( hands_[leader] )} ).first->second);
+            if ( _bounds.lb >= hi || _bounds.lb == _bounds.ub ) { return _bounds.lb; }
+            if ( _bounds.ub <= lo ) { return _bounds.ub; }
+            int const   _lo{std::max( lo, _bounds.lb - 1 )};
+            int const   _hi{std::min( hi, _bounds.ub + 1 )};
+            int const   _tricks{play_( 0, leader, -1, -1, leader, _lo, _hi )};
+            if ( _tricks > _lo ) { _bounds.lb = std::max( _bounds.lb, _tricks ); }
+            if ( _tricks < _hi ) { _bounds.ub = std::min( _bounds.ub, _tricks ); }
+            return _tricks;
+        }
+
+        int play_( int pos, int seat, int suit, int best, int wins, int lo, int hi )
+        {
+            Mask        _legal{hands_[seat]};
+            if ( pos > 0 && (_legal & Bitboard::SUIT << (16 * suit)) ) { _legal &= Bitboard::SUIT << (16 * suit); }
+            bool const  _ns{(seat & 1) != 0};
+            int         _value{_ns ? -1 : 14};
+            for ( ; _legal && lo < hi; _legal &= _legal - 1 )
+            {
+                int const   _bit{__builtin_ctzll( _legal )};
+                int         _suit{suit};
+                int         _best{best};
+                int         _wins{wins};
+                if ( pos == 0 || ((_bit >> 4) == (best >> 4) ? _bit > best : (_bit >> 4) == trump_) )
+                {
+                    if ( pos == 0 ) { _suit = _bit >> 4; }
+                    _best = _bit;
+                    _wins = seat;
+                }
+                hands_[seat] &= ~(Mask(1) << _bit);
+                int const   _won{pos == 3 ? _wins & 1 : 0};
+                int const   _tricks{pos == 3 ? _won + search_( _wins, lo - _won, hi - _won )
+                                             : play_( pos + 1, (seat + 1) & 3, _suit, _best, _wins, lo, hi )};
+                hands_[seat] |= Mask(1) << _bit;
+                if ( _ns ) { _value = std::max( _value, _tricks ); lo = std::max( lo, _tricks ); }
+                else       { _value = std::min( _value, _tricks ); hi = std::min( hi, _tricks ); }
+            }
+            return _value;
+        }
+    };
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-d W|N|E|S -s S|H|D|C|N] [-j threads] [-b] [file]\n";
+    return 2;
+}
+
+//!> deals from the input, with the line numbers of the bad ones
+std::vector<Deck> read_deals( std::istream& in, std::vector<std::size_t>& bad )
+{
+    std::vector<Deck>   _decks;
+    std::string         _line;
+    for ( std::size_t _lineno{1}; std::getline( in, _line ); ++_lineno )
+    {
+        while ( !_line.empty() && ::isspace( _line.back() ) ) { _line.pop_back(); }
+        if ( _line.empty() ) { continue; }
+        _decks.emplace_back();
+        if ( !_decks.back().load_hex( _line.c_str() ) )
+        {
+            _decks.pop_back();
+            bad.push_back( _lineno );
+        }
+    }
+    return _decks;
+}
+
+//!> DDSolver against exhaustive search on endings, all 20 results each
+std::size_t ending_check()
+{
+    // W N E S: endings where a tried card once failed to hold its run
+    // among the ranks that mattered, then random ones of 3 to 5 cards
+    Bitboard::Mask const    _known[][4]{
+        {0xc2100000010, 0xa0000000000002a, 0x481804, 0x1000010141},
+        {0x200080000020021, 0x804000000b00000, 0x8020010000006, 0x9080808},
+        {0x1800010100010000, 0x60000009200000, 0xc8002400000, 0x10002000040802},
+    };
+    std::size_t const   _endings{sizeof _known / sizeof _known[0] + 300};
+    std::mt19937_64     _rng(20251018);
+    std::size_t         _differ{0};
+    DDSolver            _solver;
+    int                 _slots[52];
+
+    for ( int _slot{0}; _slot < 52; ++_slot ) { _slots[_slot] = _slot; }
+    for ( std::size_t _ndx{0}; _ndx < _endings; ++_ndx )
+    {
+        Bitboard    _deal;
+        if ( _ndx < sizeof _known / sizeof _known[0] )
+        {
+            for ( int _seat{1}; _seat <= 4; ++_seat ) { _deal.hand( _seat ) = _known[_ndx][_seat - 1]; }
+        }
+        else
+        {
+            int const   _size{3 + static_cast<int>(_ndx % 3)};
+            std::shuffle( _slots, _slots + 52, _rng );
+            for ( int _card{0}; _card < 4 * _size; ++_card ) { _deal.hand( 1 + _card / _size ) |= Bitboard::card( _slots[_card] ); }
+        }
+        int const   _cards{_deal.count( 1 )};
+
+        DDSolver::Table _table;
+        _solver.table( _deal, _table );
+        for ( int _strain{0}; _strain <= DDSolver::NOTRUMP; ++_strain )
+        {
+            Exhaustive  _exact(_deal, _strain);
+            for ( int _declarer{1}; _declarer <= 4; ++_declarer )
+            {
+                int const   _ns{_exact.tricks( _declarer % 4 )};
+                int const   _want{(_declarer & 1) == 0 ? _ns : _cards - _ns};
+                int const   _got{_solver.tricks( _deal, _declarer, _strain )};
+                if ( _got == _want && _table[_strain][_declarer - 1] == _want ) { continue; }
+                if ( _differ++ < 5 )
+                {
+                    std::cout << std::hex;
+                    for ( int _seat{1}; _seat <= 4; ++_seat ) { std::cout << seats[_seat - 1] << '=' << _deal.hand( _seat ) << ' '; }
+                    std::cout << std::dec << strains[_strain] << " by " << seats[_declarer - 1] << ": " << _got
+                              << " (table " << _table[_strain][_declarer - 1] << "), exhaustive " << _want << "\n";
+                }
+            }
+        }
+    }
+    std::cout << "endings: " << _endings << " results: " << 20 * _endings << " differing: " << _differ << std::endl;
+    return _differ;
+}
+
+int benchmark( Options const& opts, std::vector<Deck> const& decks )
+{
+    using Clock = std::chrono::steady_clock;
+    unsigned const  _threads{opts.threads ? opts.threads : 1};
+    long            _sum{0};
+
+    auto const  _t0(Clock::now());
+    if ( opts.strain >= 0 )
+    {
+        std::vector<int>    _out(decks.size());
+        DDSolver::tricks( decks.data(), decks.size(), opts.declarer, opts.strain, _out.data(), _threads );
+        for ( int _tricks : _out ) { _sum += _tricks; }
+    }
+    else
+    {
+        std::vector<DDSolver::Table>    _out(decks.size());
+        DDSolver::table( decks.data(), decks.size(), _out.data(), _threads );
+        for ( auto const& _table : _out )
+        {
+            for ( auto const& _row : _table ) { for ( int _tricks : _row ) { _sum += _tricks; } }
+        }
+    }
+    double const _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    std::cout << (opts.strain >= 0 ? "contracts: " : "tables: ") << decks.size()
+              << " threads: " << _threads << " seconds: " << _secs << "\n"
+              << "per sec: " << (decks.size() / _secs)
+              << " per core: " << (decks.size() / _secs / _threads)
+              << " checksum: " << _sum << std::endl;
+    return ending_check() ? 1 : 0;
+}
+
+int main( int ac, char* av[] )
+{
+    Options     _opts;
+    int         _opt;
+
+    while ( (_opt = ::getopt( ac, av, "d:s:j:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'd':
+            if ( !*::optarg || !::strchr( seats, ::toupper( *::optarg ) ) ) { return usage( av[0] ); }
+            _opts.declarer = static_cast<int>(::strchr( seats, ::toupper( *::optarg ) ) - seats) + 1;
+            break;
+        case 's':
+            if ( !*::optarg || !::strchr( strains, ::toupper( *::optarg ) ) ) { return usage( av[0] ); }
+            _opts.strain = static_cast<int>(::strchr( strains, ::toupper( *::optarg ) ) - strains);
+            break;
+        case 'j': _opts.threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'b': _opts.bench   = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( (_opts.declarer == 0) != (_opts.strain < 0) ) { return usage( av[0] ); }
+
+    std::vector<std::size_t>    _bad;
+    std::vector<Deck>           _decks;
+    if ( ::optind < ac )
+    {
+        std::ifstream   _in(av[::optind]);
+        if ( !_in )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        _decks = read_deals( _in, _bad );
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        _decks = read_deals( std::cin, _bad );
+    }
+    if ( !_bad.empty() ) { std::cerr << _bad.size() << " bad deals (first at line " << _bad.front() << ")\n"; }
+    if ( _opts.bench ) { return benchmark( _opts, _decks ); }
+
+    std::string     _out;
+    char            _hex[64];
+    if ( _opts.strain >= 0 )
+    {
+        std::vector<int>    _tricks(_decks.size());
+        DDSolver::tricks( _decks.data(), _decks.size(), _opts.declarer, _opts.strain, _tricks.data(), _opts.threads );
+        for ( std::size_t _ndx{0}; _ndx < _decks.size(); ++_ndx )
+        {
+            _decks[_ndx].store_hex( _hex, sizeof _hex );
+            _out.append( _hex ).append( "  " ).append( std::to_string( _tricks[_ndx] ) ).push_back( '\n' );
+        }
+    }
+    else
+    {
+        std::vector<DDSolver::Table>    _tables(_decks.size());
+        DDSolver::table( _decks.data(), _decks.size(), _tables.data(), _opts.threads );
+        for ( std::size_t _ndx{0}; _ndx < _decks.size(); ++_ndx )
+        {
+            _decks[_ndx].store_hex( _hex, sizeof _hex );
+            _out.append( _hex ).push_back( ' ' );
+            for ( auto const& _row : _tables[_ndx] )
+            {
+                _out.push_back( ' ' );
+                for ( int _seat : order ) { _out.push_back( _row[_seat - 1] < 0 ? '-' : "0123456789abcd"[_row[_seat - 1]] ); }
+            }
+            _out.push_back( '\n' );
+        }
+    }
+    std::cout << _out << std::flush;
+    return _bad.empty() ? 0 : 1;
+}
@@ -5,8 +5,11 @@
  +========================================================================*/
 
 #include "Deal.h"
+#include "Codec.h"
+#include "DealWriter.h"
 #include "CharBuffer.h"
 
+#include <cstring>
 #include <ostream>
 #include <ctype.h>
 
@@ -17,18 +20,27 @@
         char const* format = " %c |%-14s|%-14s|%-14s|%-14s\n";
     }
 
-    void
-    Deal::visualize( std::ostream& os ) const
+    namespace
     {
-        Utility::CharBuffer<128>    _buffer;
-        os << _buffer.format( format, ' ', "WEST", "NORTH", "EAST", "SOUTH" ).get();
-        for ( int _suit{0}; _suit < 4; ++_suit )
+        template<typename Get>
+        void show( std::ostream& os, Get&& get )
         {
-            os << _buffer.format( format, Suits[_suit], 
-                                  deal_[0][_suit].get( "-" ), deal_[1][_suit].get( "-" ),
-                                  deal_[2][_suit].get( "-" ), deal_[3][_suit].get( "-" )).get();
+            Utility::CharBuffer<128>    _buffer;
+            os << _buffer.format( format, ' ', "WEST", "NORTH", "EAST", "SOUTH" ).get();
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                os << _buffer.format( format, Suits[_suit],
+                                      get( 0, _suit ).get( "-" ), get( 1, _suit ).get( "-" ),
+                                      get( 2, _suit ).get( "-" ), get( 3, _suit ).get( "-" )).get();
+            }
+            os.flush();
         }
-        os.flush();
+    }
+
+    void
+    Deal::visualize( std::ostream& os ) const
+    {
+        show( os, [this]( int seat, int suit ) -> Holding const& { return deal_[seat][suit]; } );
     }
 
     namespace
@@ -47,17 +59,6 @@
             {3, 2}, {0, 2}, {1, 2}, {2, 2}
         }};
 
-        int to_hexit( char const letter )
-        {
-            return letter > '/' && letter < ':'
-                 ? letter - '0'
-                 : letter > '@' && letter < 'G'
-                 ? letter - '7'
-                 : letter > '`' && letter < 'g'
-                 ? letter - 'W'
-                 : -1;
-        }
-
         char Cards[] = "AKQJT98765432";
     }
 
@@ -69,7 +70,7 @@
         int         _suit{0};
         while ( hex < _end )
         {
-            auto    _pr = decoder[to_hexit( *hex++ )];
+            auto    _pr = decoder[DeckCodec::hex_value( *hex++ )];
             deal_[_pr.first][_suit++].add( Cards[_index] );
             deal_[_pr.second][_suit++].add( Cards[_index] );
             if ( _suit == 4 )
@@ -112,9 +113,6 @@ namespace
 {
     char const* pbnFmt = "%s.%s.%s.%s";
     char const* linFmt = "S%sH%sD%sC%s";
-    char const* hrFmt2 = "%s %s %s %s %c %c";
-    char const* hrDlr  = "SWNE";
-    char const* hrVul  = "B-NE";
 }
 
     char* /* static */
@@ -132,10 +130,111 @@ namespace
     char* /* static */
     Deal::store_hrdv( char* buf, std::size_t len, char const* hex, int dlr, int vul )
     {
-        Deal const  _deal(hex);
-        Buffer32    _w(&Deal::store_pbn, _deal[0]);
-        Buffer32    _n(&Deal::store_pbn, _deal[1]);
-        Buffer32    _e(&Deal::store_pbn, _deal[2]);
-        Buffer32    _s(&Deal::store_pbn, _deal[3]);
-        return buf + ::snprintf( buf, len, hrFmt2, _n.get(), _e.get(), _s.get(), _w.get(), hrDlr[dlr % 4], hrVul[vul % 4] );
+        return DealWriter::gib( buf, len, Bitboard(hex), dlr, vul );
+    }
+
+//=========================================================================
+
+namespace
+{
+    //!> cards of the top 7 (AKQJT98) and bottom 6 (765432) bits of a holding
+    template<int BITS>
+    struct CardTable
+    {
+        char    cards[1 << BITS][BITS];
+        char    length[1 << BITS];
+    };
+
+    template<int BITS>
+    constexpr CardTable<BITS> make_table( char const* ranks )
+    {
+        CardTable<BITS> _table{};
+        for ( int _mask{0}; _mask < (1 << BITS); ++_mask )
+        {
+            int     _len{0};
+            for ( int _bit{BITS - 1}; _bit >= 0; --_bit )
+            {
+                if ( _mask & (1 << _bit) ) { _table.cards[_mask][_len++] = ranks[BITS - 1 - _bit]; }
+            }
+            _table.length[_mask] = static_cast<char>(_len);
+        }
+        return _table;
+    }
+
+    constexpr CardTable<7>  highCards = make_table<7>( "AKQJT98" );
+    constexpr CardTable<6>  lowCards  = make_table<6>( "765432" );
+}
+
+    char* /* static */
+    PackedDeal::store_cards( char* buf, unsigned mask )
+    {
+        unsigned const  _high{(mask >> 6) & 0x7F};
+        unsigned const  _low{mask & 0x3F};
+        std::memcpy( buf, highCards.cards[_high], highCards.length[_high] );
+        buf += highCards.length[_high];
+        std::memcpy( buf, lowCards.cards[_low], lowCards.length[_low] );
+        return buf + lowCards.length[_low];
+    }
+
+    PackedDeal&
+    PackedDeal::layout( int const* deck )
+    {
+        cards_ = Bitboard();
+        for ( int _slot{0}; _slot < 52; ++_slot )
+        {
+            if ( deck[_slot] ) { cards_.hand( deck[_slot] ) |= Bitboard::card( _slot ); }
+        }
+        return *this;
+    }
+
+    Holding
+    PackedDeal::holding( std::size_t index, int suit ) const
+    {
+        char        _cards[13];
+        Holding     _holding;
+        for ( char const* _card{_cards}, *_end{store_cards( _cards, mask( index, suit ) )}; _card < _end; ++_card )
+        {
+            _holding.add( *_card );
+        }
+        return _holding;
+    }
+
+    Hand
+    PackedDeal::operator[]( std::size_t index ) const
+    {
+        return {{ holding( index, 0 ), holding( index, 1 ), holding( index, 2 ), holding( index, 3 ) }};
+    }
+
+    char*
+    PackedDeal::store_pbn( char* buf, std::size_t len, std::size_t index ) const
+    {
+        unsigned const  _cards{static_cast<unsigned>(Bitboard::popcount( cards_.hand( int(index % 4) + 1 ) ))};
+        if ( len < _cards + 4 ) { return buf; }
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            if ( _suit ) { *buf++ = '.'; }
+            buf = store_cards( buf, mask( index, _suit ) );
+        }
+        *buf = '\0';
+        return buf;
+    }
+
+    char*
+    PackedDeal::store_lin( char* buf, std::size_t len, std::size_t index ) const
+    {
+        unsigned const  _cards{static_cast<unsigned>(Bitboard::popcount( cards_.hand( int(index % 4) + 1 ) ))};
+        if ( len < _cards + 5 ) { return buf; }
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            *buf++ = Suits[_suit];
+            buf = store_cards( buf, mask( index, _suit ) );
+        }
+        *buf = '\0';
+        return buf;
+    }
+
+    void
+    PackedDeal::visualize( std::ostream& os ) const
+    {
+        show( os, [this]( int seat, int suit ) { return holding( seat, suit ); } );
     }
@@ -8,7 +8,10 @@
 #ifndef BRIDGE_DEAL_H
 #define BRIDGE_DEAL_H
 
+#include "Bitboard.h"
+
 #include <array>
+#include <cstddef>
 #include <iosfwd>
 
     class Holding
@@ -33,7 +36,6 @@
 
     using Hand = std::array<Holding, 4>; //!< S H D C
 
-
     class Deal
     {
     public:
@@ -59,4 +61,44 @@
         std::array<Hand, 4>     deal_; //!< W N E S
     };
 
+    /**
+     * @class PackedDeal
+     * @brief A Deal kept as its Bitboard: every holding is a 13-bit rank
+     * mask, 32 bytes in all against 384 for a Deal, so the four hands of
+     * each live table can stay in memory.
+     * Card strings are made when asked for, from two lookup tables (the
+     * AKQJT98 and 765432 parts of the mask). Hands are W N E S 0..3 as in
+     * Deal.
+     */
+    class PackedDeal
+    {
+    public:
+        ~PackedDeal() noexcept = default;
+        PackedDeal() = default;
+        explicit
+        PackedDeal(int const* deck) { layout( deck ); }
+        explicit
+        PackedDeal(char const* hex) : cards_(hex) {}
+        explicit
+        PackedDeal(Bitboard const& cards) : cards_(cards) {}
+        //
+        PackedDeal& layout( int const* ); //!< usually from class Deck
+        void visualize( std::ostream& ) const;
+        //
+        unsigned mask( std::size_t index, int suit ) const { return cards_.holding( int(index % 4) + 1, suit ); }
+        Holding  holding( std::size_t index, int suit ) const;
+        Hand     operator[]( std::size_t index ) const;
+        Bitboard const& cards() const { return cards_; }
+
+        //!> hand 'index' as Deal::store_pbn / store_lin do; buf unchanged if too small
+        char* store_pbn( char* buf, std::size_t len, std::size_t index ) const;
+        char* store_lin( char* buf, std::size_t len, std::size_t index ) const;
+
+        //!> the cards of a 13-bit mask, ace first, not terminated; returns the end
+        static char* store_cards( char* buf, unsigned mask );
+
+    private:
+        Bitboard    cards_;
+    };
+
 #endif // BRIDGE_DEAL_H
@@ -0,0 +1,286 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "DealArchive.h"
+#include "Codec.h"
+#include "Bitboard.h"
+#include "DealNumber.h"
+#include "Deck.h"
+#include "Deal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+
+    constexpr std::uint32_t DealArchive::NONE;
+    constexpr std::uint32_t DealArchive::SPARSE;
+
+namespace
+{
+    char const      archiveMagic[8] = { 'B', 'R', 'I', 'D', 'G', 'E', 'D', 'A' };
+    std::uint32_t   archiveVersion{1};
+    std::uint32_t   sparseVersion{2};   //!< same, with a sparse index
+
+    // board % 16 -> 1..4 = None, NS, EW, Both (board 16 is 0)
+    constexpr int   vulCycle[16] = { 3, 1, 2, 3, 4, 2, 3, 4, 1, 3, 4, 1, 2, 4, 1, 2 };
+
+    constexpr int   seatOf[4] = { 4, 1, 2, 3 };
+
+    //!> 13 bytes, rank order, each SHDC in 2-bit chunks (low to high)
+    void pack_deck( unsigned char* out, Deck const& deck )
+    {
+        for ( int _rank{0}; _rank < 13; ++_rank )
+        {
+            *out++ = static_cast<unsigned char>((deck[_rank] % 4)
+                   | (deck[_rank + 13] % 4) << 2
+                   | (deck[_rank + 26] % 4) << 4
+                   | (deck[_rank + 39] % 4) << 6);
+        }
+    }
+
+    void unpack_deck( Deck& deck, unsigned char const* in )
+    {
+        for ( int _rank{0}; _rank < 13; ++_rank, ++in )
+        {
+            deck[_rank]      = seatOf[*in & 3];
+            deck[_rank + 13] = seatOf[(*in >> 2) & 3];
+            deck[_rank + 26] = seatOf[(*in >> 4) & 3];
+            deck[_rank + 39] = seatOf[*in >> 6];
+        }
+    }
+}
+
+    int /* static */
+    DealArchive::vul( int dv )
+    {
+        return vulCycle[dv & 15];
+    }
+
+//=========================================================================
+
+    ArchiveWriter::~ArchiveWriter() noexcept
+    {
+        close();
+    }
+
+    ArchiveWriter::ArchiveWriter(char const* file, Format fmt)
+    : file_(std::fopen( file, "wb" ))
+    , fmt_(fmt)
+    {
+        if ( !file_ ) { err_ = errno; return; }
+        DealArchive::Header _head{};
+        if ( std::fwrite( &_head, sizeof _head, 1, file_ ) != 1 ) { err_ = errno; }
+    }
+
+    bool
+    ArchiveWriter::write_( std::uint32_t tag, unsigned char const* deal, std::size_t len )
+    {
+        unsigned char   _rec[20]{0};
+        std::memcpy( _rec, &tag, sizeof tag );
+        std::memcpy( _rec + sizeof tag, deal, len );
+        if ( std::fwrite( _rec, DealArchive::width( fmt_ ), 1, file_ ) != 1 )
+        {
+            err_ = errno;
+            return false;
+        }
+        boards_.push_back( tag >> 4 );
+        return true;
+    }
+
+    bool
+    ArchiveWriter::add( Deck const& deck, int board, int dv )
+    {
+        if ( !*this || board < 0 || board >= DealArchive::BOARDS ) { return false; }
+        std::uint32_t const _tag(static_cast<std::uint32_t>(board) << 4 | ((dv < 0 ? board : dv) & 15));
+
+        if ( fmt_ == Format::RANK )
+        {
+            DealNumber::Number  _num;
+            if ( !DealNumber::rank( _num, deck ) ) { return false; }
+            DealNumber::Key const _key(DealNumber::to_key( _num ));
+            return write_( _tag, _key.data(), _key.size() );
+        }
+        if ( !Bitboard(deck).complete() ) { return false; } // packing has no out of play seat
+        unsigned char   _packed[13];
+        pack_deck( _packed, deck );
+        return write_( _tag, _packed, sizeof _packed );
+    }
+
+    bool
+    ArchiveWriter::add_hex( char const* hex, int board, int dv )
+    {
+        Deck    _deck;
+        return _deck.load_hex( hex ) && add( _deck, board, dv );
+    }
+
+    bool
+    ArchiveWriter::close()
+    {
+        if ( !file_ ) { return false; }
+
+        DealArchive::Header _head{};
+        std::memcpy( _head.magic, archiveMagic, sizeof _head.magic );
+        _head.version = archiveVersion;
+        _head.format  = fmt_;
+        _head.width   = DealArchive::width( fmt_ );
+        _head.count   = boards_.size();
+        _head.index   = sizeof _head + _head.count * _head.width;
+        if ( !boards_.empty() )
+        {
+            auto    _mm(std::minmax_element( boards_.begin(), boards_.end() ));
+            _head.first = *_mm.first;
+            _head.last  = *_mm.second;
+
+            // first record wins for repeated boards
+            std::vector<std::uint32_t>  _index;
+            std::vector<std::uint32_t>  _order(boards_.size());
+            for ( std::uint32_t _ndx{0}; _ndx < _order.size(); ++_ndx ) { _order[_ndx] = _ndx; }
+            std::stable_sort( _order.begin(), _order.end(), [this]( std::uint32_t a, std::uint32_t b )
+            {
+                return boards_[a] < boards_[b];
+            });
+            for ( std::size_t _ndx{0}; _ndx < _order.size(); ++_ndx )
+            {
+                if ( _ndx == 0 || boards_[_order[_ndx]] != boards_[_order[_ndx - 1]] ) { ++_head.entries; }
+            }
+            if ( 2 * _head.entries < std::uint64_t(_head.last - _head.first) + 1 )
+            {
+                // pairs take less room than a slot for every board in the range
+                _head.version = sparseVersion;
+                _head.flags   = DealArchive::SPARSE;
+                _index.reserve( 2 * _head.entries );
+                for ( std::size_t _ndx{0}; _ndx < _order.size(); ++_ndx )
+                {
+                    if ( _ndx > 0 && boards_[_order[_ndx]] == boards_[_order[_ndx - 1]] ) { continue; }
+                    _index.push_back( boards_[_order[_ndx]] );
+                    _index.push_back( _order[_ndx] );
+                }
+            }
+            else
+            {
+                _head.entries = 0;
+                _index.assign( _head.last - _head.first + 1, DealArchive::NONE );
+                for ( std::uint32_t _ndx(boards_.size()); _ndx-- > 0; )
+                {
+                    _index[boards_[_ndx] - _head.first] = _ndx;
+                }
+            }
+            if ( std::fwrite( _index.data(), sizeof(std::uint32_t), _index.size(), file_ ) != _index.size() )
+            {
+                err_ = errno;
+            }
+        }
+        if ( err_ == 0 && (std::fseek( file_, 0, SEEK_SET ) != 0
+                        || std::fwrite( &_head, sizeof _head, 1, file_ ) != 1) )
+        {
+            err_ = errno;
+        }
+        if ( std::fclose( file_ ) != 0 && err_ == 0 ) { err_ = errno; }
+        file_ = nullptr;
+        return err_ == 0;
+    }
+
+//=========================================================================
+
+    std::uint32_t
+    ArchiveReader::Entry::tag_() const
+    {
+        std::uint32_t   _tag;
+        std::memcpy( &_tag, ptr_, sizeof _tag );
+        return _tag;
+    }
+
+    bool
+    ArchiveReader::Entry::load( Deck& deck ) const
+    {
+        if ( fmt_ == Format::RANK )
+        {
+            return DealNumber::unrank( deck, DealNumber::fr_key( data() ) );
+        }
+        unpack_deck( deck, data() );
+        return true;
+    }
+
+    Deal&
+    ArchiveReader::Entry::load( Deal& deal ) const
+    {
+        Deck    _deck;
+        load( _deck );
+        return deal.reset().layout( _deck.begin() );
+    }
+
+    char*
+    ArchiveReader::Entry::store_hex( char* hex, std::size_t len ) const
+    {
+        if ( len > 0 && len < 27 ) { return hex; }
+        if ( fmt_ == Format::RANK )
+        {
+            Deck    _deck;
+            load( _deck );
+            return _deck.store_hex( hex, len );
+        }
+        unsigned char const*    _in{data()};
+        for ( int _rank{0}; _rank < 13; ++_rank, ++_in )
+        {
+            *hex++ = DeckCodec::hex_digit( *_in & 15 );
+            *hex++ = DeckCodec::hex_digit( *_in >> 4 );
+        }
+        *hex = '\0';
+        return hex;
+    }
+
+    ArchiveReader::ArchiveReader(char const* file)
+    : file_(file)
+    {
+        if ( !file_ ) { err_ = file_.error(); return; }
+
+        auto const* _head(reinterpret_cast<DealArchive::Header const*>(file_.get()));
+        if ( file_.size() < sizeof *_head
+          || std::memcmp( _head->magic, archiveMagic, sizeof _head->magic ) != 0
+          || (_head->version != archiveVersion && _head->version != sparseVersion)
+          || (_head->format != Format::HEX && _head->format != Format::RANK)
+          || _head->width != DealArchive::width( _head->format ) )
+        {
+            err_ = EINVAL;
+            return;
+        }
+        bool const          _sparse{_head->version == sparseVersion && (_head->flags & DealArchive::SPARSE)};
+        std::size_t const   _slots(!_head->count ? 0 : _sparse ? 2 * _head->entries : _head->last - _head->first + 1);
+        if ( _head->index != sizeof *_head + _head->count * _head->width
+          || (_sparse && _head->entries > _head->count)
+          || file_.size() < _head->index + _slots * sizeof(std::uint32_t) )
+        {
+            err_ = EINVAL;
+            return;
+        }
+        head_  = _head;
+        base_  = reinterpret_cast<unsigned char const*>(file_.get()) + sizeof *_head;
+        index_ = reinterpret_cast<std::uint32_t const*>(file_.get() + _head->index);
+    }
+
+    bool
+    ArchiveReader::find( int board, std::size_t& ndx ) const
+    {
+        if ( !head_ || head_->count == 0 || board < first() || board > last() ) { return false; }
+        std::uint32_t   _rec{DealArchive::NONE};
+        if ( sparse() )
+        {
+            // bisect the pairs on their board numbers
+            std::size_t _lo{0};
+            std::size_t _hi{head_->entries};
+            while ( _lo < _hi )
+            {
+                std::size_t const   _mid{_lo + (_hi - _lo) / 2};
+                if ( index_[2 * _mid] < static_cast<std::uint32_t>(board) ) { _lo = _mid + 1; }
+                else { _hi = _mid; }
+            }
+            if ( _lo < head_->entries && index_[2 * _lo] == static_cast<std::uint32_t>(board) ) { _rec = index_[2 * _lo + 1]; }
+        }
+        else { _rec = index_[board - head_->first]; }
+        if ( _rec == DealArchive::NONE || _rec >= head_->count ) { return false; }
+        ndx = _rec;
+        return true;
+    }
@@ -0,0 +1,189 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_DEALARCHIVE_H
+#define BRIDGE_DEALARCHIVE_H
+
+#include "StrFile.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <iterator>
+
+class Deck;
+class Deal;
+
+    /**
+     * Binary hand-record archive.
+     * Layout (native byte order):
+     *   Header       64 bytes, see below
+     *   Records      count * width bytes, in insertion order
+     *   Index        (last - first + 1) uint32 record numbers, by board;
+     *                or, with the SPARSE flag (version 2), 'entries' pairs
+     *                of uint32 board and record number, sorted by board,
+     *                when that is less than half the size
+     * Each record starts with a uint32: board number << 4 | dv nibble
+     * (the dealer/vulnerability digit of README.txt, i.e. board % 16 for
+     * the standard cycle), followed by the deal:
+     *   HEX  13 packed bytes of the hex string (low nybble first), 3 pad
+     *   RANK 12-byte DealNumber key
+     */
+    class DealArchive
+    {
+    public:
+        enum class Format : std::uint32_t { HEX, RANK };
+
+        struct Header
+        {
+            char            magic[8];
+            std::uint32_t   version;
+            Format          format;
+            std::uint32_t   width;   //!< record size
+            std::uint32_t   first;   //!< lowest board
+            std::uint32_t   last;    //!< highest board
+            std::uint32_t   flags;   //!< SPARSE; 0 in version 1
+            std::uint64_t   count;   //!< records
+            std::uint64_t   index;   //!< file offset of the index
+            std::uint64_t   entries; //!< (board, record) pairs if SPARSE
+            std::uint64_t   pad1;
+        };
+        static_assert( sizeof(Header) == 64, "archive header" );
+
+        static constexpr std::uint32_t NONE = 0xFFFFFFFFu; //!< no record for board
+        static constexpr std::uint32_t SPARSE = 1;          //!< Header::flags
+        static constexpr int BOARDS = 1 << 28;
+
+        static std::uint32_t width( Format fmt ) { return fmt == Format::HEX ? 20 : 16; }
+        //!> standard cycle: dealer seat (WNES 1..4) and vulnerability (1..4 = None, NS, EW, Both)
+        static int dealer( int dv ) { return dv % 4 + 1; }
+        static int vul( int dv );
+    };
+
+    /**
+     * @class ArchiveWriter
+     * Streams records to the file, keeps only the board numbers in
+     * memory, and writes the index and final header on close().
+     */
+    class ArchiveWriter
+    {
+    public:
+        using Format = DealArchive::Format;
+
+        ~ArchiveWriter() noexcept;
+        ArchiveWriter(char const* file, Format fmt = Format::HEX);
+
+        explicit operator bool() const { return file_ != nullptr && err_ == 0; }
+        int error() const { return err_; }
+
+        //!> dv < 0 means the standard board % 16
+        bool add( Deck const&, int board, int dv = -1 );
+        bool add_hex( char const* hex, int board, int dv = -1 );
+        std::size_t size() const { return boards_.size(); }
+        bool close();
+
+    private:
+        std::FILE*                  file_{nullptr};
+        Format                      fmt_;
+        std::vector<std::uint32_t>  boards_;
+        int                         err_{0};
+
+        bool write_( std::uint32_t tag, unsigned char const* deal, std::size_t len );
+
+        ArchiveWriter(ArchiveWriter const&) = delete;
+        ArchiveWriter& operator=( ArchiveWriter const& ) = delete;
+    };
+
+    /**
+     * @class ArchiveReader
+     * Maps the file (Utility::StrFile); records are viewed in place.
+     */
+    class ArchiveReader
+    {
+    public:
+        using Format = DealArchive::Format;
+
+        //!> a record in the mapped file
+        class Entry
+        {
+        public:
+            explicit
+            Entry(unsigned char const* ptr, Format fmt) : ptr_(ptr), fmt_(fmt) {}
+
+            int board() const { return static_cast<int>(tag_() >> 4); }
+            int dv() const { return static_cast<int>(tag_() & 15); }
+            int dealer() const { return DealArchive::dealer( dv() ); }
+            int vul() const { return DealArchive::vul( dv() ); }
+
+            bool  load( Deck& ) const;
+            Deal& load( Deal& ) const;
+            char* store_hex( char*, std::size_t = 0 ) const;
+            unsigned char const* data() const { return ptr_ + 4; }
+
+        private:
+            unsigned char const*    ptr_;
+            Format                  fmt_;
+
+            std::uint32_t tag_() const;
+        };
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Entry;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = Entry const*;
+            using reference         = Entry;
+
+            iterator(unsigned char const* ptr, Format fmt, std::size_t width)
+            : ptr_(ptr), fmt_(fmt), width_(width)
+            {}
+            Entry operator*() const { return Entry(ptr_, fmt_); }
+            iterator& operator++() { ptr_ += width_; return *this; }
+            bool operator==( iterator const& other ) const { return ptr_ == other.ptr_; }
+            bool operator!=( iterator const& other ) const { return ptr_ != other.ptr_; }
+        private:
+            unsigned char const*    ptr_;
+            Format                  fmt_;
+            std::size_t             width_;
+        };
+
+        ~ArchiveReader() noexcept = default;
+        explicit
+        ArchiveReader(char const* file);
+
+        explicit operator bool() const { return head_ != nullptr; }
+        int error() const { return err_; }
+
+        //!> after a failed open: HEX, empty, boards 0..0
+        Format format() const { return head_ ? head_->format : Format::HEX; }
+        std::size_t size() const { return head_ ? head_->count : 0; }
+        int first() const { return head_ ? head_->first : 0; }
+        int last() const { return head_ ? head_->last : 0; }
+        //!> the index is (board, record) pairs rather than a slot per board
+        bool sparse() const { return head_ && head_->version > 1 && (head_->flags & DealArchive::SPARSE); }
+
+        Entry at( std::size_t ndx ) const { return Entry(base_ + ndx * width_(), format()); }
+        //!> by board number, O(1) or O(log n) if the index is sparse;
+        //!> false if the board is not in the archive
+        bool find( int board, std::size_t& ndx ) const;
+
+        iterator begin() const { return iterator(base_, format(), width_()); }
+        iterator end() const { return iterator(base_ + size() * width_(), format(), width_()); }
+
+    private:
+        Utility::StrFile        file_;
+        DealArchive::Header const* head_{nullptr};
+        unsigned char const*    base_{nullptr};
+        std::uint32_t const*    index_{nullptr};
+        int                     err_{0};
+
+        std::size_t width_() const { return head_ ? head_->width : 0; }
+    };
+
+#endif // BRIDGE_DEALARCHIVE_H
@@ -0,0 +1,171 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Bitboard.h"
+#include "Constraint.h"
+#include "DealArchive.h"
+#include "Deck.h"
+#include "FeatureIndex.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+
+    /**
+     * DealFind: deals of an archive by hand features (see FeatureIndex.h).
+     *   DealFind -o file.fx file.arc            index an archive
+     *   DealFind [-a file.arc] [-c] file.fx spec
+     *   DealFind -b -a file.arc file.fx spec    time against a full scan
+     * The spec is as for GenDeals -c (seat clauses only), e.g.
+     *   DealFind -a 2024.arc 2024.fx "N: s=5 h=5 hcp=10-12"
+     * Matches print as record numbers or, with the archive, as the board
+     * and hex deal; -c prints only the count. -b also decodes every deal
+     * of the archive, checks it with the spec, and compares the two.
+     */
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " -o file.fx file.arc\n"
+              << "       " << prog << " [-a file.arc] [-c] [-b] file.fx spec\n";
+    return 2;
+}
+
+int build( char const* file, char const* archive )
+{
+    ArchiveReader   _arc(archive);
+    if ( !_arc )
+    {
+        std::cerr << "Cannot read " << archive << ": " << ::strerror( _arc.error() ) << "\n";
+        return 1;
+    }
+    FeatureIndex    _index;
+    auto const      _t0(std::chrono::steady_clock::now());
+    std::size_t const   _added{_index.load( _arc )};
+    double const    _secs{std::chrono::duration<double>(std::chrono::steady_clock::now() - _t0).count()};
+    if ( _added != _arc.size() )
+    {
+        std::cerr << archive << ": record " << _added << " is not a full deal, no index written\n";
+        return 1;
+    }
+    if ( !_index.save( file ) )
+    {
+        std::cerr << "Error writing " << file << ": " << ::strerror( _index.error() ) << "\n";
+        return 1;
+    }
+    std::cerr << archive << ": " << _added << " deals indexed in " << _secs << " sec\n";
+    return 0;
+}
+
+int benchmark( FeatureIndex const& index, ArchiveReader const& arc, char const* spec, FeatureIndex::Query const& query )
+{
+    using Clock = std::chrono::steady_clock;
+    DealFilter  _filter(spec);
+    if ( !_filter )
+    {
+        std::cerr << "Bad spec: " << _filter.error() << "\n";
+        return 2;
+    }
+
+    std::vector<std::uint64_t>  _found;
+    auto const  _t0(Clock::now());
+    index.match( query, &_found );
+    auto const  _t1(Clock::now());
+    std::vector<std::uint64_t>  _scanned;
+    Deck        _deck;
+    std::size_t _ndx{0};
+    for ( auto const& _entry : arc )
+    {
+        if ( _entry.load( _deck ) && _filter( Bitboard(_deck) ) ) { _scanned.push_back( _ndx ); }
+        ++_ndx;
+    }
+    auto const  _t2(Clock::now());
+
+    std::cout << "deals: " << index.size() << " matches: " << _found.size() << "\n"
+              << "index: " << std::chrono::duration<double, std::milli>(_t1 - _t0).count() << " ms\n"
+              << "scan: " << std::chrono::duration<double, std::milli>(_t2 - _t1).count() << " ms\n"
+              << (_found == _scanned ? "same deals" : "DIFFERENT deals") << std::endl;
+    return _found == _scanned ? 0 : 1;
+}
+
+int main( int ac, char* av[] )
+{
+    char const* _out{nullptr};
+    char const* _archive{nullptr};
+    bool        _count{false};
+    bool        _bench{false};
+    int         _opt;
+
+    while ( (_opt = ::getopt( ac, av, "o:a:cb" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'o': _out     = ::optarg; break;
+        case 'a': _archive = ::optarg; break;
+        case 'c': _count   = true; break;
+        case 'b': _bench   = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( _out ) { return ::optind + 1 == ac ? build( _out, av[::optind] ) : usage( av[0] ); }
+    if ( ::optind + 2 != ac || (_bench && !_archive) ) { return usage( av[0] ); }
+
+    FeatureIndex    _index;
+    if ( !_index.open( av[::optind] ) )
+    {
+        std::cerr << "Cannot read " << av[::optind] << ": " << ::strerror( _index.error() ) << "\n";
+        return 1;
+    }
+    char const* const           _spec{av[::optind + 1]};
+    FeatureIndex::Query const   _query(_spec);
+    if ( !_query )
+    {
+        std::cerr << "Bad spec: " << _query.error() << "\n";
+        return 2;
+    }
+    std::unique_ptr<ArchiveReader>  _arc;
+    if ( _archive )
+    {
+        _arc.reset( new ArchiveReader(_archive) );
+        if ( !*_arc )
+        {
+            std::cerr << "Cannot read " << _archive << ": " << ::strerror( _arc->error() ) << "\n";
+            return 1;
+        }
+        if ( _arc->size() != _index.size() )
+        {
+            std::cerr << _archive << " has " << _arc->size() << " deals, the index " << _index.size() << "\n";
+            return 1;
+        }
+    }
+    if ( _bench ) { return benchmark( _index, *_arc, _spec, _query ); }
+    if ( _count )
+    {
+        std::cout << _index.match( _query ) << std::endl;
+        return 0;
+    }
+
+    std::vector<std::uint64_t>  _found;
+    std::string                 _text;
+    char                        _hex[64];
+    _index.match( _query, &_found );
+    for ( std::uint64_t _ndx : _found )
+    {
+        if ( _arc )
+        {
+            ArchiveReader::Entry const  _entry(_arc->at( _ndx ));
+            _entry.store_hex( _hex, sizeof _hex );
+            _text.append( std::to_string( _entry.board() ) ).append( "  " ).append( _hex );
+        }
+        else { _text.append( std::to_string( _ndx ) ); }
+        _text.push_back( '\n' );
+    }
+    std::cout << _text << std::flush;
+    return 0;
+}
@@ -0,0 +1,164 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "DealIndex.h"
+#include "DealArchive.h"
+#include "Generator.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * DealIdx: the index of deals already played (see DealIndex.h).
+     *   DealIdx -o file.idx [-s session] a.arc [b.arc...]   add archives
+     *   DealIdx file.idx [file]     look up hex deals (STDIN by default)
+     *   DealIdx -b file.idx         time lookups
+     * Archives are added under sessions -s, -s + 1, ... to the index in
+     * file.idx, which is created if it does not exist. A lookup prints
+     * each deal with "session:board", or "-" if it is new.
+     */
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " -o file.idx [-s session] file.arc...\n"
+              << "       " << prog << " [-b] file.idx [file]\n";
+    return 2;
+}
+
+int build( char const* file, std::uint32_t session, int ac, char* av[] )
+{
+    DealIndex   _index;
+    if ( std::FILE* _fp = std::fopen( file, "rb" ) )
+    {
+        std::fclose( _fp );
+        if ( !_index.open( file ) )
+        {
+            std::cerr << "Cannot read " << file << ": " << ::strerror( _index.error() ) << "\n";
+            return 1;
+        }
+    }
+    for ( int _ndx{0}; _ndx < ac; ++_ndx, ++session )
+    {
+        ArchiveReader   _arc(av[_ndx]);
+        if ( !_arc )
+        {
+            std::cerr << "Cannot read " << av[_ndx] << ": " << ::strerror( _arc.error() ) << "\n";
+            return 1;
+        }
+        std::size_t const   _added{_index.load( _arc, session )};
+        std::cerr << av[_ndx] << ": " << _added << " of " << _arc.size() << " deals added as session " << session << "\n";
+    }
+    if ( !_index.save( file ) )
+    {
+        std::cerr << "Error writing " << file << ": " << ::strerror( _index.error() ) << "\n";
+        return 1;
+    }
+    std::cerr << _index.size() << " deals\n";
+    return 0;
+}
+
+int lookup( DealIndex const& index, std::istream& in )
+{
+    std::string     _line;
+    std::string     _out;
+    std::size_t     _bad{0};
+    while ( std::getline( in, _line ) )
+    {
+        while ( !_line.empty() && ::isspace( _line.back() ) ) { _line.pop_back(); }
+        if ( _line.empty() ) { continue; }
+        Deck    _deck;
+        if ( !_deck.load_hex( _line.c_str() ) ) { ++_bad; continue; }
+        DealIndex::Meta _meta;
+        _out.append( _line ).append( "  " );
+        if ( index.find( _deck, _meta ) )
+        {
+            _out.append( std::to_string( _meta.session ) ).append( ":" ).append( std::to_string( _meta.board() ) );
+        }
+        else { _out.push_back( '-' ); }
+        _out.push_back( '\n' );
+    }
+    std::cout << _out << std::flush;
+    if ( _bad ) { std::cerr << _bad << " bad deals\n"; }
+    return _bad ? 1 : 0;
+}
+
+// fresh deals from the generator: nearly all misses
+int benchmark( DealIndex const& index )
+{
+    using Clock = std::chrono::steady_clock;
+    std::size_t const   _count{1 << 18};
+    std::vector<Deck>   _decks(_count);
+    DealGenerator(std::uint64_t(Clock::now().time_since_epoch().count())).deal( _decks.data(), 1, _count, 1 );
+
+    std::vector<DealIndex::Key> _keys(_count);
+    auto const  _t0(Clock::now());
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        DealNumber::Number  _num;
+        DealNumber::rank( _num, _decks[_ndx] );
+        _keys[_ndx] = DealNumber::to_key( _num );
+    }
+    auto const  _t1(Clock::now());
+    std::size_t _hits{0};
+    for ( auto const& _key : _keys ) { _hits += index.contains( _key ); }
+    auto const  _t2(Clock::now());
+    double const _rank{std::chrono::duration<double>(_t1 - _t0).count()};
+    double const _find{std::chrono::duration<double>(_t2 - _t1).count()};
+
+    std::cout << "index: " << index.size() << " deals, " << index.capacity() << " slots\n"
+              << "lookups: " << _count << " hits: " << _hits << "\n"
+              << "keys/sec: " << (_count / _rank) << " lookups/sec: " << (_count / _find) << std::endl;
+    return 0;
+}
+
+int main( int ac, char* av[] )
+{
+    char const*     _out{nullptr};
+    std::uint32_t   _session{1};
+    bool            _bench{false};
+    int             _opt;
+
+    while ( (_opt = ::getopt( ac, av, "o:s:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'o': _out     = ::optarg; break;
+        case 's': _session = static_cast<std::uint32_t>(std::strtoul( ::optarg, nullptr, 10 )); break;
+        case 'b': _bench   = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( _out ) { return build( _out, _session, ac - ::optind, av + ::optind ); }
+    if ( ::optind >= ac ) { return usage( av[0] ); }
+
+    DealIndex   _index;
+    if ( !_index.open( av[::optind] ) )
+    {
+        std::cerr << "Cannot read " << av[::optind] << ": " << ::strerror( _index.error() ) << "\n";
+        return 1;
+    }
+    if ( _bench ) { return benchmark( _index ); }
+    if ( ::optind + 1 < ac )
+    {
+        std::ifstream   _in(av[::optind + 1]);
+        if ( !_in )
+        {
+            std::cerr << "Cannot open " << av[::optind + 1] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        return lookup( _index, _in );
+    }
+    std::cerr << "Reading from STDIN\n";
+    return lookup( _index, std::cin );
+}
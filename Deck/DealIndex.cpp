@@ -0,0 +1,224 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "DealIndex.h"
+#include "DealArchive.h"
+#include "Deck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <errno.h>
+
+namespace
+{
+    char const      indexMagic[8] = { 'B', 'R', 'I', 'D', 'G', 'E', 'I', 'X' };
+    std::uint32_t   indexVersion{1};
+
+    struct Header
+    {
+        char            magic[8];
+        std::uint32_t   version;
+        std::uint32_t   width;      //!< slot size
+        std::uint64_t   count;
+        std::uint64_t   capacity;   //!< slots, a power of 2
+        std::uint64_t   pad[4];
+    };
+    static_assert( sizeof(Header) == 64, "index header" );
+
+    //!> deal numbers are below 2^96, so all ones is never a key
+    unsigned char const empty[12] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+    inline
+    std::uint64_t hash( unsigned char const* key )
+    {
+        std::uint64_t   _lo;
+        std::uint32_t   _hi;
+        std::memcpy( &_hi, key, sizeof _hi );
+        std::memcpy( &_lo, key + 4, sizeof _lo );
+        std::uint64_t   _h{(_lo ^ (std::uint64_t(_hi) << 32 | _hi)) * 0x9E3779B97F4A7C15ull};
+        return _h ^ (_h >> 29);
+    }
+
+    bool to_key( DealIndex::Key& key, Deck const& deck )
+    {
+        DealNumber::Number  _num;
+        if ( !DealNumber::rank( _num, deck ) ) { return false; }
+        key = DealNumber::to_key( _num );
+        return true;
+    }
+}
+
+    DealIndex::DealIndex(std::size_t expected)
+    {
+        std::size_t _capacity{16};
+        while ( 10 * expected > 7 * _capacity ) { _capacity *= 2; }
+        grow_( _capacity );
+    }
+
+    // the slot with the key, or the empty slot that ends its run
+    DealIndex::Slot const*
+    DealIndex::probe_( unsigned char const* key ) const
+    {
+        std::size_t const   _mask{capacity_ - 1};
+        for ( std::size_t _ndx{hash( key ) & _mask}; ; _ndx = (_ndx + 1) & _mask )
+        {
+            Slot const& _slot(slots_[_ndx]);
+            if ( std::memcmp( _slot.key, key, sizeof _slot.key ) == 0
+              || std::memcmp( _slot.key, empty, sizeof empty ) == 0 ) { return &_slot; }
+        }
+    }
+
+    // rehash into owned slots; an opened file is let go
+    void
+    DealIndex::grow_( std::size_t capacity )
+    {
+        std::vector<Slot>   _slots(capacity);
+        for ( auto& _slot : _slots ) { std::memcpy( _slot.key, empty, sizeof empty ); }
+        std::swap( own_, _slots );
+        Slot const* _old{slots_};
+        std::size_t _size{capacity_};
+        slots_    = own_.data();
+        capacity_ = capacity;
+        for ( std::size_t _ndx{0}; _ndx < _size; ++_ndx )
+        {
+            if ( std::memcmp( _old[_ndx].key, empty, sizeof empty ) == 0 ) { continue; }
+            *const_cast<Slot*>(probe_( _old[_ndx].key )) = _old[_ndx];
+        }
+        file_.reset();
+    }
+
+    bool
+    DealIndex::insert( Key const& key, Meta const& meta )
+    {
+        if ( 10 * (count_ + 1) > 7 * capacity_ ) { grow_( 2 * capacity_ ); }
+        Slot*   _slot{const_cast<Slot*>(probe_( key.data() ))};
+        if ( std::memcmp( _slot->key, empty, sizeof empty ) != 0 ) { return false; }
+        std::memcpy( _slot->key, key.data(), sizeof _slot->key );
+        _slot->session = meta.session;
+        _slot->tag     = meta.tag;
+        ++count_;
+        return true;
+    }
+
+    bool
+    DealIndex::insert( Deck const& deck, Meta const& meta )
+    {
+        Key     _key;
+        return to_key( _key, deck ) && insert( _key, meta );
+    }
+
+    bool
+    DealIndex::find( Key const& key, Meta& meta ) const
+    {
+        Slot const* _slot{probe_( key.data() )};
+        if ( std::memcmp( _slot->key, empty, sizeof empty ) == 0 ) { return false; }
+        meta.session = _slot->session;
+        meta.tag     = _slot->tag;
+        return true;
+    }
+
+    bool
+    DealIndex::find( Deck const& deck, Meta& meta ) const
+    {
+        Key     _key;
+        return to_key( _key, deck ) && find( _key, meta );
+    }
+
+    bool
+    DealIndex::find( char const* hex, Meta& meta ) const
+    {
+        Deck    _deck;
+        return _deck.load_hex( hex ) && find( _deck, meta );
+    }
+
+    std::size_t
+    DealIndex::contains( Deck const* decks, std::size_t count, bool* seen ) const
+    {
+        std::size_t _seen{0};
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            _seen += (seen[_ndx] = contains( decks[_ndx] ));
+        }
+        return _seen;
+    }
+
+    std::size_t
+    DealIndex::load( ArchiveReader const& arc, std::uint32_t session )
+    {
+        std::size_t const   _before{count_};
+        std::size_t         _capacity{capacity_};
+        while ( 10 * (count_ + arc.size()) > 7 * _capacity ) { _capacity *= 2; }
+        if ( _capacity != capacity_ ) { grow_( _capacity ); }
+
+        Deck    _deck;
+        Key     _key;
+        for ( auto const& _entry : arc )
+        {
+            Meta const  _meta{session, static_cast<std::uint32_t>(_entry.board()) << 4 | static_cast<std::uint32_t>(_entry.dv())};
+            if ( arc.format() == DealArchive::Format::RANK )
+            {
+                std::copy( _entry.data(), _entry.data() + _key.size(), _key.begin() );
+                insert( _key, _meta );
+            }
+            else if ( _entry.load( _deck ) ) { insert( _deck, _meta ); }
+        }
+        return count_ - _before;
+    }
+
+    bool
+    DealIndex::save( char const* file )
+    {
+        Header  _head{};
+        std::memcpy( _head.magic, indexMagic, sizeof _head.magic );
+        _head.version  = indexVersion;
+        _head.width    = sizeof(Slot);
+        _head.count    = count_;
+        _head.capacity = capacity_;
+
+        // by way of a temporary, since the file may be the one mapped
+        std::string const   _temp{std::string(file) + ".tmp"};
+        std::FILE*          _fp{std::fopen( _temp.c_str(), "wb" )};
+        if ( !_fp ) { err_ = errno; return false; }
+        err_ = 0;
+        if ( std::fwrite( &_head, sizeof _head, 1, _fp ) != 1
+          || std::fwrite( slots_, sizeof(Slot), capacity_, _fp ) != capacity_ )
+        {
+            err_ = errno;
+        }
+        if ( std::fclose( _fp ) != 0 && err_ == 0 ) { err_ = errno; }
+        if ( err_ == 0 && std::rename( _temp.c_str(), file ) != 0 ) { err_ = errno; }
+        if ( err_ != 0 ) { std::remove( _temp.c_str() ); }
+        return err_ == 0;
+    }
+
+    bool
+    DealIndex::open( char const* file )
+    {
+        std::unique_ptr<Utility::StrFile>   _file(new Utility::StrFile(file));
+        if ( !*_file ) { err_ = _file->error(); return false; }
+
+        auto const* _head(reinterpret_cast<Header const*>(_file->get()));
+        if ( _file->size() < sizeof *_head
+          || std::memcmp( _head->magic, indexMagic, sizeof _head->magic ) != 0
+          || _head->version != indexVersion
+          || _head->width != sizeof(Slot)
+          || _head->capacity < 16 || (_head->capacity & (_head->capacity - 1)) != 0
+          || _head->count * 10 > _head->capacity * 7
+          || _file->size() < sizeof *_head + _head->capacity * sizeof(Slot) )
+        {
+            err_ = EINVAL;
+            return false;
+        }
+        capacity_ = _head->capacity;
+        count_    = _head->count;
+        slots_    = reinterpret_cast<Slot*>(_file->get() + sizeof *_head);
+        file_     = std::move( _file );
+        own_      = std::vector<Slot>();
+        err_      = 0;
+        return true;
+    }
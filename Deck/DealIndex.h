@@ -0,0 +1,98 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_DEALINDEX_H
+#define BRIDGE_DEALINDEX_H
+
+#include "DealNumber.h"
+#include "StrFile.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Deck;
+class ArchiveReader;
+
+    /**
+     * @class DealIndex
+     * @brief Set of deals seen, with where each was played.
+     * Keyed by the 12-byte DealNumber key, so the hex layout of a deal and
+     * its rank find the same entry. Open addressing with linear probing
+     * over 20-byte slots (key, session, tag), grown by doubling at 70%
+     * load; the first entry for a deal is kept.
+     *
+     * The file form is a 64-byte header and the slot array as is, so
+     * open() maps it (Utility::StrFile, copy on write) and lookups run on
+     * the mapped pages with no rebuild. Inserting into an opened index
+     * works on the private pages until it has to grow.
+     */
+    class DealIndex
+    {
+    public:
+        using Key = DealNumber::Key;
+
+        //!> where a deal was played; tag is board << 4 | dv, as in DealArchive
+        struct Meta
+        {
+            std::uint32_t   session{0};
+            std::uint32_t   tag{0};
+
+            int board() const { return static_cast<int>(tag >> 4); }
+            int dv() const { return static_cast<int>(tag & 15); }
+        };
+
+        ~DealIndex() noexcept = default;
+        //!> room for 'expected' deals without growing
+        explicit
+        DealIndex(std::size_t expected = 0);
+
+        std::size_t size() const { return count_; }
+        std::size_t capacity() const { return capacity_; }
+
+        //!> false if the deal was already there (or is not a full deal)
+        bool insert( Key const&, Meta const& );
+        bool insert( Deck const&, Meta const& );
+
+        bool find( Key const&, Meta& ) const;
+        bool find( Deck const&, Meta& ) const;
+        bool find( char const* hex, Meta& ) const;
+        bool contains( Key const& key ) const { Meta _meta; return find( key, _meta ); }
+        bool contains( Deck const& deck ) const { Meta _meta; return find( deck, _meta ); }
+        //!> seen[i] for decks[i]; returns how many were seen
+        std::size_t contains( Deck const* decks, std::size_t count, bool* seen ) const;
+
+        //!> every record of an archive, under 'session'; returns the number added
+        std::size_t load( ArchiveReader const&, std::uint32_t session );
+
+        //!> the file form; open() replaces the contents, false (errno in error()) on failure
+        bool save( char const* file );
+        bool open( char const* file );
+        int error() const { return err_; }
+
+    private:
+        struct Slot
+        {
+            unsigned char   key[12];
+            std::uint32_t   session;
+            std::uint32_t   tag;
+        };
+        static_assert( sizeof(Slot) == 20, "index slot" );
+
+        std::unique_ptr<Utility::StrFile>   file_;  //!< when opened
+        std::vector<Slot>                   own_;   //!< otherwise
+        Slot*                               slots_{nullptr};
+        std::size_t                         capacity_{0};
+        std::size_t                         count_{0};
+        int                                 err_{0};
+
+        Slot const* probe_( unsigned char const* key ) const;
+        void        grow_( std::size_t capacity );
+    };
+
+#endif // BRIDGE_DEALINDEX_H
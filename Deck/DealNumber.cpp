@@ -0,0 +1,191 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "DealNumber.h"
+#include "Codec.h"
+#include "Deck.h"
+
+#include <cstdint>
+
+namespace
+{
+    using Number = DealNumber::Number;
+
+    //!> Pascal's triangle, C(n, k) for n <= 52, k <= 13
+    struct Binomials
+    {
+        std::uint64_t   at[53][14];
+    };
+
+    constexpr Binomials make_binomials()
+    {
+        Binomials   _b{};
+        for ( int _n{0}; _n <= 52; ++_n )
+        {
+            _b.at[_n][0] = 1;
+            for ( int _k{1}; _k <= 13; ++_k )
+            {
+                _b.at[_n][_k] = _n == 0 ? 0 : _b.at[_n - 1][_k - 1] + _b.at[_n - 1][_k];
+            }
+        }
+        return _b;
+    }
+
+    constexpr Binomials binom = make_binomials();
+
+    constexpr std::uint64_t C52{binom.at[52][13]};
+    constexpr std::uint64_t C39{binom.at[39][13]};
+    constexpr std::uint64_t C26{binom.at[26][13]};
+
+    //!> colex unrank of a 13-subset of n positions, as a bitmask of positions
+    std::uint64_t unrank13( std::uint64_t rank, int n )
+    {
+        std::uint64_t   _set{0};
+        int             _k{13};
+        while ( n-- > 0 )
+        {
+            std::uint64_t const _c{binom.at[n][_k]};
+            std::uint64_t const _take{_c <= rank}; // branch free
+            rank -= _c & (0 - _take);
+            _set |= _take << n;
+            _k   -= static_cast<int>(_take);
+        }
+        return _set;
+    }
+}
+
+    DealNumber::Number /* static */
+    DealNumber::total()
+    {
+        return (Number(C52) * C39) * C26;
+    }
+
+    // one pass, branch free but for stopping once a seat has more than 13
+    // cards (binom has 14 columns): each seat's position counter only
+    // advances over cards not taken by the seats ahead of it in WNE order.
+    bool /* static */
+    DealNumber::rank( Number& num, Deck const& deck )
+    {
+        std::uint64_t   _rw{0}, _rn{0}, _re{0};
+        int             _kw{0}, _kn{0}, _ke{0}, _ks{0};
+        int             _pn{0}, _pe{0};
+        int             _bad{0};
+
+        for ( int _slot{0}; _slot < 52; ++_slot )
+        {
+            int const   _seat{deck[_slot]};
+            int const   _w{_seat == 1}, _n{_seat == 2}, _e{_seat == 3}, _s{_seat == 4};
+            _bad |= !(_w | _n | _e | _s);
+            _kw += _w;
+            _kn += _n;
+            _ke += _e;
+            _ks += _s;
+            if ( _kw > 13 || _kn > 13 || _ke > 13 || _ks > 13 ) { return false; }
+            _rw += binom.at[_slot][_kw] & (0 - std::uint64_t(_w));
+            _rn += binom.at[_pn][_kn]   & (0 - std::uint64_t(_n));
+            _re += binom.at[_pe][_ke]   & (0 - std::uint64_t(_e));
+            _pn += !_w;
+            _pe += _e | _s;
+        }
+        if ( _bad || _kw != 13 || _kn != 13 || _ke != 13 || _ks != 13 ) { return false; }
+        num = (Number(_rw) * C39 + _rn) * C26 + _re;
+        return true;
+    }
+
+    bool /* static */
+    DealNumber::unrank( Deck& deck, Number num )
+    {
+        if ( num >= total() ) { return false; }
+        std::uint64_t const _re(num % C26);
+        num /= C26;
+        std::uint64_t const _rn(num % C39);
+        std::uint64_t const _rw(num / C39);
+
+        std::uint64_t const _w{unrank13( _rw, 52 )};
+        std::uint64_t const _n{unrank13( _rn, 39 )};
+        std::uint64_t const _e{unrank13( _re, 26 )};
+        int                 _pn{0}, _pe{0};
+
+        for ( int _slot{0}; _slot < 52; ++_slot )
+        {
+            if ( _w >> _slot & 1 ) { deck[_slot] = 1; continue; }
+            if ( _n >> _pn++ & 1 ) { deck[_slot] = 2; continue; }
+            deck[_slot] = (_e >> _pe++ & 1) ? 3 : 4;
+        }
+        return true;
+    }
+
+    std::size_t /* static */
+    DealNumber::rank( Number* nums, Deck const* decks, std::size_t count, bool* ok )
+    {
+        std::size_t     _valid{0};
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            bool    _ok{rank( nums[_ndx], decks[_ndx] )};
+            if ( ok ) { ok[_ndx] = _ok; }
+            _valid += _ok;
+        }
+        return _valid;
+    }
+
+    std::size_t /* static */
+    DealNumber::unrank( Deck* decks, Number const* nums, std::size_t count, bool* ok )
+    {
+        std::size_t     _valid{0};
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            bool    _ok{unrank( decks[_ndx], nums[_ndx] )};
+            if ( ok ) { ok[_ndx] = _ok; }
+            _valid += _ok;
+        }
+        return _valid;
+    }
+
+    DealNumber::Key /* static */
+    DealNumber::to_key( Number num )
+    {
+        Key     _key;
+        for ( int _ndx{11}; _ndx >= 0; --_ndx, num >>= 8 )
+        {
+            _key[_ndx] = static_cast<unsigned char>(num & 0xFF);
+        }
+        return _key;
+    }
+
+    DealNumber::Number /* static */
+    DealNumber::fr_key( unsigned char const* key )
+    {
+        Number  _num{0};
+        for ( int _ndx{0}; _ndx < 12; ++_ndx ) { _num = _num << 8 | key[_ndx]; }
+        return _num;
+    }
+
+    char* /* static */
+    DealNumber::store_key( char* buf, std::size_t len, Number num )
+    {
+        if ( len > 0 && len < 25 ) { return buf; }
+        for ( int _ndx{23}; _ndx >= 0; --_ndx, num >>= 4 )
+        {
+            buf[_ndx] = DeckCodec::hex_digit( static_cast<unsigned>(num & 0xF) );
+        }
+        buf += 24;
+        *buf = '\0';
+        return buf;
+    }
+
+    bool /* static */
+    DealNumber::load_key( Number& num, char const* buf )
+    {
+        Number  _num{0};
+        for ( int _ndx{0}; _ndx < 24; ++_ndx )
+        {
+            int _hexit{DeckCodec::hex_value( buf[_ndx] )};
+            if ( _hexit < 0 ) { return false; }
+            _num = _num << 4 | _hexit;
+        }
+        num = _num;
+        return true;
+    }
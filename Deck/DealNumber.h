@@ -0,0 +1,51 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_DEALNUMBER_H
+#define BRIDGE_DEALNUMBER_H
+
+#include <array>
+#include <cstddef>
+
+class Deck;
+
+    /**
+     * @class DealNumber
+     * @brief Maps a full deal to its index in [0, 52!/(13!)^4) and back.
+     * The index is mixed radix over three colex combination ranks:
+     *   ((W * C(39,13)) + N) * C(26,13) + E
+     * where W is West's 13 slots among all 52, N is North's among the 39
+     * left, and E is East's among the 26 left (South gets the rest).
+     * Keys are the 12-byte big-endian form, so memcmp order is index order.
+     */
+    class DealNumber
+    {
+    public:
+        using Number = unsigned __int128;
+        using Key    = std::array<unsigned char, 12>;
+
+        static Number total(); //!< number of deals, a tad under 2^96
+
+        //!> false if the deck is not a full deal (13 cards each)
+        static bool rank( Number&, Deck const& );
+        //!> false if the number is out of range
+        static bool unrank( Deck&, Number );
+
+        //!> batches; return the number of valid entries, ok[i] (if given) per entry
+        static std::size_t rank( Number* nums, Deck const* decks, std::size_t count, bool* ok = nullptr );
+        static std::size_t unrank( Deck* decks, Number const* nums, std::size_t count, bool* ok = nullptr );
+
+        static Key    to_key( Number );
+        static Number fr_key( unsigned char const* );
+        static Number fr_key( Key const& key ) { return fr_key( key.data() ); }
+
+        //!> 24 hex digits
+        static char* store_key( char* buf, std::size_t len, Number );
+        static bool  load_key( Number&, char const* );
+    };
+
+#endif // BRIDGE_DEALNUMBER_H
@@ -0,0 +1,170 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Bitboard.h"
+#include "HandStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * DealStats: hand features over hex deals, one per line.
+     *   DealStats [-j threads] [-b] [file]
+     * Prints the average points, controls and losers by seat and side and
+     * the frequency of each hand pattern. -b times the AVX2 and portable
+     * kernels instead, and checks that they agree. With no file, STDIN is
+     * read.
+     */
+
+namespace
+{
+    char const  seats[] = "WNES";
+    char const  sides[][3] = {"NS", "EW"};
+
+    template<typename Column>
+    double mean( Column const& col )
+    {
+        double  _sum{0};
+        for ( auto _value : col ) { _sum += _value; }
+        return col.empty() ? 0 : _sum / col.size();
+    }
+
+    bool same( HandStats const& one, HandStats const& two )
+    {
+        return one.hcp == two.hcp && one.length == two.length && one.pattern == two.pattern
+            && one.controls == two.controls && one.losers == two.losers
+            && one.side_hcp == two.side_hcp && one.side_length == two.side_length
+            && one.side_controls == two.side_controls && one.side_losers == two.side_losers;
+    }
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-j threads] [-b] [file]\n";
+    return 2;
+}
+
+std::vector<Bitboard> read_deals( std::istream& in, std::size_t& bad )
+{
+    std::vector<Bitboard>   _deals;
+    std::string             _line;
+    while ( std::getline( in, _line ) )
+    {
+        while ( !_line.empty() && ::isspace( _line.back() ) ) { _line.pop_back(); }
+        if ( _line.empty() ) { continue; }
+        _deals.emplace_back();
+        if ( !_deals.back().load_hex( _line.c_str() ) || !_deals.back().complete() )
+        {
+            _deals.pop_back();
+            ++bad;
+        }
+    }
+    return _deals;
+}
+
+int benchmark( std::vector<Bitboard> const& deals, unsigned threads )
+{
+    using Clock = std::chrono::steady_clock;
+    HandStats   _simd;
+    HandStats   _swar;
+    threads = threads ? threads : 1;
+
+    auto const  _t0(Clock::now());
+    _simd.evaluate( deals.data(), deals.size(), threads );
+    auto const  _t1(Clock::now());
+    _swar.evaluate_swar( deals.data(), deals.size(), threads );
+    auto const  _t2(Clock::now());
+    double const _fast{std::chrono::duration<double>(_t1 - _t0).count()};
+    double const _slow{std::chrono::duration<double>(_t2 - _t1).count()};
+    bool const   _same{same( _simd, _swar )};
+
+    std::cout << "deals: " << deals.size() << " threads: " << threads
+              << " kernel: " << (HandStats::simd() ? "avx2" : "swar") << "\n"
+              << "deals/sec: " << (deals.size() / _fast)
+              << " swar deals/sec: " << (deals.size() / _slow)
+              << (_same ? "" : "  (MISMATCH)") << std::endl;
+    return _same ? 0 : 1;
+}
+
+int main( int ac, char* av[] )
+{
+    unsigned    _threads{0};
+    bool        _bench{false};
+    int         _opt;
+
+    while ( (_opt = ::getopt( ac, av, "j:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'j': _threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'b': _bench   = true; break;
+        default: return usage( av[0] );
+        }
+    }
+
+    std::size_t             _bad{0};
+    std::vector<Bitboard>   _deals;
+    if ( ::optind < ac )
+    {
+        std::ifstream   _in(av[::optind]);
+        if ( !_in )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        _deals = read_deals( _in, _bad );
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        _deals = read_deals( std::cin, _bad );
+    }
+    if ( _bad ) { std::cerr << _bad << " bad deals\n"; }
+    if ( _bench ) { return benchmark( _deals, _threads ); }
+
+    HandStats   _stats;
+    _stats.evaluate( _deals.data(), _deals.size(), _threads );
+
+    std::cout << "deals: " << _stats.size() << "\n" << std::fixed << std::setprecision( 2 )
+              << "seat     hcp  controls  losers\n";
+    for ( int _ndx{0}; _ndx < 4; ++_ndx )
+    {
+        std::cout << "  " << seats[_ndx] << "  " << std::setw( 8 ) << mean( _stats.hcp[_ndx] )
+                  << std::setw( 10 ) << mean( _stats.controls[_ndx] )
+                  << std::setw( 8 ) << mean( _stats.losers[_ndx] ) << "\n";
+    }
+    for ( int _side{0}; _side < 2; ++_side )
+    {
+        std::cout << " " << sides[_side] << "  " << std::setw( 8 ) << mean( _stats.side_hcp[_side] )
+                  << std::setw( 10 ) << mean( _stats.side_controls[_side] )
+                  << std::setw( 8 ) << mean( _stats.side_losers[_side] ) << "\n";
+    }
+
+    // patterns over all four seats, most frequent first
+    std::map<int, std::size_t>  _patterns;
+    for ( auto const& _col : _stats.pattern ) { for ( auto _code : _col ) { ++_patterns[_code]; } }
+    std::vector<std::pair<std::size_t, int>>    _order;
+    for ( auto const& _entry : _patterns ) { _order.emplace_back( _entry.second, _entry.first ); }
+    std::sort( _order.begin(), _order.end(), std::greater<std::pair<std::size_t, int>>() );
+    std::cout << "pattern  hands       %\n";
+    for ( auto const& _entry : _order )
+    {
+        std::cout << "  " << _entry.second << std::setw( 9 ) << _entry.first
+                  << std::setw( 8 ) << (100.0 * _entry.first / (4 * _stats.size())) << "\n";
+    }
+    std::cout << std::flush;
+    return _bad ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "DealWriter.h"
+#include "Deal.h"
+#include "Deck.h"
+
+namespace
+{
+    char const  Suits[] = "SHDC";
+    char const  pbnDlr[] = "SWNE";
+    char const  linDlr[] = "1234";
+    char const  hrDlr[]  = "SWNE";
+    char const  hrVul[]  = "B-NE";
+
+    //!> dealer round from dlr % 4 (S W N E) as seats WNES 1..4
+    constexpr int   firstSeat[] = { 4, 1, 2, 3 };
+
+    //!> 13-bit holding, ace first
+    inline
+    char* put_holding( char* buf, unsigned holding ) { return PackedDeal::store_cards( buf, holding ); }
+
+    inline
+    char* put_pbn( char* buf, Bitboard const& deal, int seat )
+    {
+        buf = put_holding( buf, deal.holding( seat, 0 ) );
+        *buf++ = '.';
+        buf = put_holding( buf, deal.holding( seat, 1 ) );
+        *buf++ = '.';
+        buf = put_holding( buf, deal.holding( seat, 2 ) );
+        *buf++ = '.';
+        return put_holding( buf, deal.holding( seat, 3 ) );
+    }
+
+    inline
+    char* put_lin( char* buf, Bitboard const& deal, int seat )
+    {
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            *buf++ = Suits[_suit];
+            buf = put_holding( buf, deal.holding( seat, _suit ) );
+        }
+        return buf;
+    }
+
+    inline
+    bool fits( std::size_t len, std::size_t need ) { return len == 0 || len > need; }
+}
+
+    char* /* static */
+    DealWriter::pbn( char* buf, std::size_t len, Bitboard const& deal, int dlr )
+    {
+        int const   _first{firstSeat[dlr % 4]};
+        if ( !fits( len, 17 + Bitboard::popcount( deal.hand( 1 ) | deal.hand( 2 ) | deal.hand( 3 ) | deal.hand( 4 ) ) ) )
+        {
+            return buf;
+        }
+        *buf++ = pbnDlr[dlr % 4];
+        *buf++ = ':';
+        for ( int _count{0}, _seat{_first}; _count < 4; ++_count, _seat = _seat % 4 + 1 )
+        {
+            if ( _count ) { *buf++ = ' '; }
+            buf = put_pbn( buf, deal, _seat );
+        }
+        *buf = '\0';
+        return buf;
+    }
+
+    // South, West and North; East is implied
+    char* /* static */
+    DealWriter::lin( char* buf, std::size_t len, Bitboard const& deal, int dlr )
+    {
+        if ( !fits( len, 15 + Bitboard::popcount( deal.hand( 4 ) | deal.hand( 1 ) | deal.hand( 2 ) ) ) ) { return buf; }
+        *buf++ = linDlr[dlr % 4];
+        buf = put_lin( buf, deal, 4 );
+        *buf++ = ',';
+        buf = put_lin( buf, deal, 1 );
+        *buf++ = ',';
+        buf = put_lin( buf, deal, 2 );
+        *buf = '\0';
+        return buf;
+    }
+
+    char* /* static */
+    DealWriter::record( char* buf, std::size_t len, Bitboard const& deal, int dlr, int vul, bool oneline )
+    {
+        if ( !fits( len, 19 + Bitboard::popcount( deal.hand( 1 ) | deal.hand( 2 ) | deal.hand( 3 ) | deal.hand( 4 ) ) ) )
+        {
+            return buf;
+        }
+        char const  _sep{oneline ? ' ' : '\n'};
+        for ( int _seat : { 2, 3, 4, 1 } )
+        {
+            buf = put_pbn( buf, deal, _seat );
+            *buf++ = _sep;
+        }
+        *buf++ = hrDlr[dlr % 4];
+        *buf++ = ' ';
+        *buf++ = hrVul[vul % 4];
+        *buf = '\0';
+        return buf;
+    }
+
+    char* /* static */
+    DealWriter::pbn( char* buf, std::size_t len, Deck const& deck, int dlr )
+    {
+        return pbn( buf, len, Bitboard(deck), dlr );
+    }
+
+    char* /* static */
+    DealWriter::lin( char* buf, std::size_t len, Deck const& deck, int dlr )
+    {
+        return lin( buf, len, Bitboard(deck), dlr );
+    }
+
+    char* /* static */
+    DealWriter::record( char* buf, std::size_t len, Deck const& deck, int dlr, int vul, bool oneline )
+    {
+        return record( buf, len, Bitboard(deck), dlr, vul, oneline );
+    }
+
+    char* /* static */
+    DealWriter::hex( char* buf, std::size_t len, Deck const& deck )
+    {
+        return deck.store_hex( buf, len );
+    }
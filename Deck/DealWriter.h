@@ -0,0 +1,56 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_DEALWRITER_H
+#define BRIDGE_DEALWRITER_H
+
+#include "Bitboard.h"
+
+#include <cstddef>
+
+class Deck;
+
+    /**
+     * @class DealWriter
+     * @brief Deal strings written straight from the layout, with no Deal,
+     * no intermediate holdings and no printf.
+     * Each writer fills [buf, buf + len) and returns the end (where the
+     * terminating NUL is), or buf with nothing written if len is too small;
+     * len 0 means the buffer is known to be large enough (see LENGTH). The
+     * output is the same as that of the Deck::store_ methods, which use it:
+     *   pbn    "N:KQ2.A5.T83.AJ97 ..." from the dealer round, dlr % 4 S W N E
+     *   lin    "3SKQ2HA5D...,S...,S..." dealer digit, then South, West, North
+     *   record the four PBN hands N, E, S, W, dealer (SWNE) and vulnerability
+     *          (B-NE), one per line or, as for GIB, on one line
+     *   hex    as Bitboard::store_hex
+     * A PackedDeal is written through its cards().
+     */
+    class DealWriter
+    {
+    public:
+        enum { LENGTH = 80 }; //!< enough for any of the formats
+
+        static char* pbn( char* buf, std::size_t len, Bitboard const& deal, int dlr );
+        static char* lin( char* buf, std::size_t len, Bitboard const& deal, int dlr );
+        static char* record( char* buf, std::size_t len, Bitboard const& deal, int dlr, int vul, bool oneline );
+        static char* gib( char* buf, std::size_t len, Bitboard const& deal, int dlr, int vul )
+        {
+            return record( buf, len, deal, dlr, vul, true );
+        }
+        static char* hex( char* buf, std::size_t len, Bitboard const& deal ) { return deal.store_hex( buf, len ); }
+
+        static char* pbn( char* buf, std::size_t len, Deck const& deck, int dlr );
+        static char* lin( char* buf, std::size_t len, Deck const& deck, int dlr );
+        static char* record( char* buf, std::size_t len, Deck const& deck, int dlr, int vul, bool oneline );
+        static char* gib( char* buf, std::size_t len, Deck const& deck, int dlr, int vul )
+        {
+            return record( buf, len, deck, dlr, vul, true );
+        }
+        static char* hex( char* buf, std::size_t len, Deck const& deck );
+    };
+
+#endif // BRIDGE_DEALWRITER_H
@@ -5,11 +5,12 @@
  +========================================================================*/
 
 #include "Deck.h"
-#include "Deal.h"
-#include "CharBuffer.h"
+#include "Codec.h"
+#include "DealWriter.h"
 
-#include <unordered_map>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 
 // seat [ENSWensw]
 // suit [CDHScdhs]
@@ -23,73 +24,36 @@ namespace
 
     constexpr std::array<int, 5>  clockwise = { 0, 2, 3, 4, 1 };
 
-    using CharMap = std::unordered_map<char, int>;
-
-    CharMap seatMap =
-    {
-        {'S', 4}, {'s', 4}, {'W', 1}, {'w', 1},
-        {'N', 2}, {'n', 2}, {'E', 3}, {'e', 3}
-    };
-
-    CharMap suitMap =
+    //!> 256-entry char lookup, -1 for "not in the alphabet"
+    struct CharMap
     {
-        {'S', 0}, {'s', 0}, {'H', 1}, {'h', 1},
-        {'D', 2}, {'d', 2}, {'C', 3}, {'c', 3}
+        signed char at[256];
+        int operator[]( char c ) const { return at[static_cast<unsigned char>(c)]; }
     };
 
-    CharMap cardMap =
+    constexpr CharMap make_map( char const* keys, int const* values )
     {
-        {'A', 0}, {'a', 0}, {'K', 1}, {'k', 1}, {'Q', 2},
-        {'q', 2}, {'J', 3}, {'j', 3}, {'T', 4}, {'t', 4},
-        {'9', 5}, {'8', 6}, {'7', 7}, {'6', 8}, {'5', 9},
-        {'4', 10}, {'3', 11}, {'2', 12}
-    };
-
-    constexpr char const hexTable[] = "0123456789ABCDEF";
+        CharMap _map{};
+        for ( int _c{0}; _c < 256; ++_c ) { _map.at[_c] = -1; }
+        for ( ; *keys; ++keys, ++values ) { _map.at[static_cast<unsigned char>(*keys)] = *values; }
+        return _map;
+    }
 
-    //!> Map hex digit to a pair of 2-bits of seats
-    std::unordered_map<char, std::array<int, 2>> hexDecoder =
+    constexpr int seatVals[] = { 4, 4, 1, 1, 2, 2, 3, 3 };
+    constexpr int suitVals[] = { 0, 0, 1, 1, 2, 2, 3, 3 };
+    constexpr int cardVals[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    constexpr int alphaVals[] =
     {
-        { '0', { 4, 4 } },
-        { '1', { 1, 4 } },
-        { '2', { 2, 4 } },
-        { '3', { 3, 4 } },
-        { '4', { 4, 1 } },
-        { '5', { 1, 1 } },
-        { '6', { 2, 1 } },
-        { '7', { 3, 1 } },
-        { '8', { 4, 2 } },
-        { '9', { 1, 2 } },
-        { 'A', { 2, 2 } },
-        { 'B', { 3, 2 } },
-        { 'C', { 4, 3 } },
-        { 'D', { 1, 3 } },
-        { 'E', { 2, 3 } },
-        { 'F', { 3, 3 } },
-        { 'a', { 2, 2 } },
-        { 'b', { 3, 2 } },
-        { 'c', { 4, 3 } },
-        { 'd', { 1, 3 } },
-        { 'e', { 2, 3 } },
-        { 'f', { 3, 3 } },
+         0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,
+        13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,
+        26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
+        39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51
     };
 
-    std::unordered_map<char, int> alphaDecoder =
-    {
-        { 'A',  0 }, { 'B',  1 }, { 'C',  2 }, { 'D',  3 },
-        { 'E',  4 }, { 'F',  5 }, { 'G',  6 }, { 'H',  7 },
-        { 'I',  8 }, { 'J',  9 }, { 'K', 10 }, { 'L', 11 },
-        { 'M', 12 }, { 'N', 13 }, { 'O', 14 }, { 'P', 15 },
-        { 'Q', 16 }, { 'R', 17 }, { 'S', 18 }, { 'T', 19 },
-        { 'U', 20 }, { 'V', 21 }, { 'W', 22 }, { 'X', 23 },
-        { 'Y', 24 }, { 'Z', 25 }, { 'a', 26 }, { 'b', 27 },
-        { 'c', 28 }, { 'd', 29 }, { 'e', 30 }, { 'f', 31 },
-        { 'g', 32 }, { 'h', 33 }, { 'i', 34 }, { 'j', 35 },
-        { 'k', 36 }, { 'l', 37 }, { 'm', 38 }, { 'n', 39 },
-        { 'o', 40 }, { 'p', 41 }, { 'q', 42 }, { 'r', 43 },
-        { 's', 44 }, { 't', 45 }, { 'u', 46 }, { 'v', 47 },
-        { 'w', 48 }, { 'x', 49 }, { 'y', 50 }, { 'z', 51 },
-    };
+    constexpr CharMap seatMap = make_map( "SsWwNnEe", seatVals );
+    constexpr CharMap suitMap = make_map( "SsHhDdCc", suitVals );
+    constexpr CharMap cardMap = make_map( "AaKkQqJjTt98765432", cardVals );
+    constexpr CharMap alphaDecoder = make_map( "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", alphaVals );
 
     constexpr char const alphaTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
@@ -98,56 +62,21 @@ namespace
     bool /* static */
     Deck::verify_hex( char const* hex )
     {
-        std::array<int, 4>  _counts{0, 0, 0, 0};
-        char const*         _end = hex + 26;
-
-        do {
-            ++_counts[hexDecoder[*hex][0] % 4];
-            ++_counts[hexDecoder[*hex][1] % 4];
-        } while ( ++hex < _end );
-
-        for ( auto const& _count : _counts ) if ( _count != 13 ) { return false; }
-        return true;
-        //return std::find_if( _counts.begin(), _counts.end(),
-        //    []( int num ) -> bool { return num != 13; } ) == _counts.end();
+        return DeckCodec::verify_hex( hex );
     }
 
     bool
     Deck::load_hex( char const* hex )
     {
-        char const* _end = hex + 26;
-
-        int* s = &deck_[0];
-        int* h = &deck_[13];
-        int* d = &deck_[26];
-        int* c = &deck_[39];
-
-        while ( hex < _end )
-        {
-            *s++ = hexDecoder[*hex][0];
-            *h++ = hexDecoder[*hex++][1];
-            *d++ = hexDecoder[*hex][0];
-            *c++ = hexDecoder[*hex++][1];
-        }
-        return true;
+        return DeckCodec::decode_hex( deck_.data(), hex );
     }
 
     char*
     Deck::store_hex( char* hex, std::size_t len ) const
     {
         if ( len > 0 && len < 27 ) { return hex; }
-        char const* _end = hex + 26;
-
-        int const* s = &deck_[0];
-        int const* h = &deck_[13];
-        int const* d = &deck_[26];
-        int const* c = &deck_[39];
-
-        while ( hex < _end )
-        {
-            *hex++ = hexTable[(*s++ % 4) | (*h++ % 4) << 2];
-            *hex++ = hexTable[(*d++ % 4) | (*c++ % 4) << 2];
-        }
+        DeckCodec::encode_hex( hex, deck_.data() );
+        hex += 26;
         *hex = 0;
         return hex;
     }
@@ -168,7 +97,7 @@ namespace
         default: return false;
         }
         //
-        for ( pbn += 2; *pbn; ++pbn )
+        for ( pbn += 2; *pbn && *pbn != '\n' && *pbn != '\r'; ++pbn )
         switch ( *pbn )
         {
         case '.':
@@ -198,7 +127,7 @@ namespace
         int     _commas{0};
         //
         ++lin; //!< skip dealer
-        for ( ; *lin; ++lin )
+        for ( ; *lin && *lin != '\n' && *lin != '\r'; ++lin )
         switch ( *lin )
         {
         case 'S': case 's': _suit =  0; break;
@@ -236,6 +165,7 @@ namespace
         for ( ; bhg < _end; ++bhg )
         {
             int _slot(alphaDecoder[*bhg]);
+            if ( _slot < 0 ) { return false; }
             if ( _slot < _pslot ) { seat = clockwise[seat]; }
             deck_[_slot] = seat;
             _pslot = _slot;
@@ -274,19 +204,6 @@ namespace
     }
 //=========================================================================
 
-namespace
-{
-    char const* pbnFmt = "%c:%s %s %s %s";
-    char const* linFmt = "%c%s,%s,%s";
-    char const* linDlr = "1234";
-    char const* hrFmt  = "%s\n%s\n%s\n%s\n%c %c";
-    char const* hrFmt2 = "%s %s %s %s %c %c";
-    char const* hrDlr  = "SWNE";
-    char const* hrVul  = "B-NE";
-}
-    using Buf20 = Utility::CharBuffer<20>;
-
-
     char*
     Deck::store_record( char* buf, std::size_t len, int dlr, int vul ) const
     {
@@ -296,43 +213,19 @@ namespace
     char*
     Deck::store_record_x( char* buf, std::size_t len, int dlr, int vul, bool oneline ) const
     {
-        Deal const  _deal(deck_.begin());
-        Buf20       _w(&Deal::store_pbn, _deal[0]);
-        Buf20       _n(&Deal::store_pbn, _deal[1]);
-        Buf20       _e(&Deal::store_pbn, _deal[2]);
-        Buf20       _s(&Deal::store_pbn, _deal[3]);
-
-        return buf + ::snprintf( buf, len, (oneline ? hrFmt2 : hrFmt), _n.get(), _e.get(), _s.get(), _w.get(), hrDlr[dlr % 4], hrVul[vul % 4] );
+        return DealWriter::record( buf, len, *this, dlr, vul, oneline );
     }
 
     char*
     Deck::store_pbn_s( char* buf, std::size_t len, int dlr ) const
     {
-        Deal const  _deal(deck_.begin());
-        Buf20       _w(&Deal::store_pbn, _deal[0]);
-        Buf20       _n(&Deal::store_pbn, _deal[1]);
-        Buf20       _e(&Deal::store_pbn, _deal[2]);
-        Buf20       _s(&Deal::store_pbn, _deal[3]);
-
-        switch ( dlr % 4 )
-        {
-        case 0: return buf + ::snprintf( buf, len, pbnFmt, 'S', _s.get(), _w.get(), _n.get(), _e.get());
-        case 1: return buf + ::snprintf( buf, len, pbnFmt, 'W', _w.get(), _n.get(), _e.get(), _s.get());
-        case 2: return buf + ::snprintf( buf, len, pbnFmt, 'N', _n.get(), _e.get(), _s.get(), _w.get());
-        case 3: return buf + ::snprintf( buf, len, pbnFmt, 'E', _e.get(), _s.get(), _w.get(), _n.get());
-        default: return buf;
-        }
+        return DealWriter::pbn( buf, len, *this, dlr );
     }
 
     char*
     Deck::store_lin_s( char* buf, std::size_t len, int dlr ) const
     {
-        Deal const  _deal(deck_.begin());
-        Buf20       _s(&Deal::store_lin, _deal[3]);
-        Buf20       _w(&Deal::store_lin, _deal[0]);
-        Buf20       _n(&Deal::store_lin, _deal[1]);
-
-        return buf + ::snprintf( buf, len, linFmt, linDlr[dlr % 4], _s.get(), _w.get(), _n.get());
+        return DealWriter::lin( buf, len, *this, dlr );
     }
 
     char*
@@ -349,11 +242,175 @@ namespace
     void /* static */
     Deck::get_hcp( int* hcp, char const* hex )
     {
+        // AKQJ are the first 8 chars; 2-bit chunks are seats 0..3 (SWNE)
         for ( int _pts{4}; _pts > 0; --_pts )
         {
-            hcp[hexDecoder[*hex][0] % 4]   += _pts;
-            hcp[hexDecoder[*hex++][1] % 4] += _pts;
-            hcp[hexDecoder[*hex][0] % 4]   += _pts;
-            hcp[hexDecoder[*hex++][1] % 4] += _pts;
+            int _e{DeckCodec::hex_value( *hex++ )};
+            int _o{DeckCodec::hex_value( *hex++ )};
+            hcp[_e & 3]        += _pts;
+            hcp[(_e >> 2) & 3] += _pts;
+            hcp[_o & 3]        += _pts;
+            hcp[(_o >> 2) & 3] += _pts;
+        }
+    }
+//=========================================================================
+
+namespace
+{
+    char const  base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    constexpr int   base64Vals[] =
+    {
+         0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21,
+        22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43,
+        44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63
+    };
+    constexpr CharMap base64Map = make_map( base64, base64Vals );
+
+    enum { PACKED = 13, OUTMASK = 7 };
+
+    std::string to_base64( std::uint8_t const* bytes, std::size_t len )
+    {
+        std::string _text;
+        _text.reserve( (len + 2) / 3 * 4 );
+        for ( std::size_t _ndx{0}; _ndx < len; _ndx += 3 )
+        {
+            unsigned const  _n{ unsigned(bytes[_ndx]) << 16
+                              | (_ndx + 1 < len ? unsigned(bytes[_ndx + 1]) << 8 : 0)
+                              | (_ndx + 2 < len ? unsigned(bytes[_ndx + 2]) : 0) };
+            _text += base64[(_n >> 18) & 63];
+            _text += base64[(_n >> 12) & 63];
+            _text += _ndx + 1 < len ? base64[(_n >> 6) & 63] : '=';
+            _text += _ndx + 2 < len ? base64[_n & 63] : '=';
+        }
+        return _text;
+    }
+
+    //!> returns the number of bytes, 0 if not base64 or too long
+    std::size_t fr_base64( std::uint8_t* bytes, std::size_t max, std::string const& text )
+    {
+        if ( text.size() % 4 != 0 ) { return 0; }
+        std::size_t _len{0};
+        for ( std::size_t _ndx{0}; _ndx < text.size(); _ndx += 4 )
+        {
+            unsigned    _n{0};
+            int         _pad{0};
+            for ( int _ch{0}; _ch < 4; ++_ch )
+            {
+                char const  _c{text[_ndx + _ch]};
+                int const   _v{base64Map[_c]};
+                if ( _c == '=' && _ndx + 4 == text.size() && _ch >= 2 ) { ++_pad; _n <<= 6; continue; }
+                if ( _v < 0 || _pad ) { return 0; }
+                _n = _n << 6 | unsigned(_v);
+            }
+            for ( int _byte{0}; _byte < 3 - _pad; ++_byte )
+            {
+                if ( _len == max ) { return 0; }
+                bytes[_len++] = static_cast<std::uint8_t>(_n >> (16 - 8 * _byte));
+            }
+        }
+        return _len;
+    }
+}
+
+    // the bytes of the hex string (README.txt section 2): rank r is byte r, SH in the high nibble
+    std::uint8_t*
+    Deck::store_packed( std::uint8_t* bytes ) const
+    {
+        bool    _out{false};
+        for ( int _rank{0}; _rank < 13; ++_rank )
+        {
+            *bytes++ = static_cast<std::uint8_t>( (deck_[_rank] & 3) << 4
+                                                | (deck_[_rank + 13] & 3) << 6
+                                                | (deck_[_rank + 26] & 3)
+                                                | (deck_[_rank + 39] & 3) << 2 );
+            _out = _out || !deck_[_rank] || !deck_[_rank + 13] || !deck_[_rank + 26] || !deck_[_rank + 39];
+        }
+        if ( !_out ) { return bytes; }
+        std::uint64_t   _mask{0};
+        for ( int _slot{0}; _slot < DECKSIZE; ++_slot )
+        {
+            if ( !deck_[_slot] ) { _mask |= std::uint64_t(1) << _slot; }
+        }
+        for ( int _byte{0}; _byte < OUTMASK; ++_byte ) { *bytes++ = static_cast<std::uint8_t>(_mask >> (8 * _byte)); }
+        return bytes;
+    }
+
+    bool
+    Deck::load_packed( std::uint8_t const* bytes, std::size_t len )
+    {
+        if ( len != PACKED && len != PACKED + OUTMASK ) { return false; }
+        std::uint64_t   _mask{0};
+        for ( std::size_t _byte{PACKED}; _byte < len; ++_byte ) { _mask |= std::uint64_t(bytes[_byte]) << (8 * (_byte - PACKED)); }
+        if ( _mask >> DECKSIZE ) { return false; }
+
+        std::array<int, DECKSIZE>   _deck;
+        std::array<int, 5>          _count{{0, 0, 0, 0, 0}};
+        for ( int _slot{0}; _slot < DECKSIZE; ++_slot )
+        {
+            int const   _code{(bytes[_slot % 13] >> (2 * ((_slot / 13 + 2) % 4))) & 3};
+            _deck[_slot] = (_mask >> _slot) & 1 ? 0 : _code ? _code : 4;
+            ++_count[_deck[_slot]];
+        }
+        if ( _count[1] > 13 || _count[2] > 13 || _count[3] > 13 || _count[4] > 13 ) { return false; }
+        deck_ = _deck;
+        return true;
+    }
+
+    void
+    Deck::to_js( nlohmann::json& j, Wire wire ) const
+    {
+        switch ( wire )
+        {
+        case Wire::HEX:
+            if ( std::find( deck_.begin(), deck_.end(), 0 ) == deck_.end() )
+            {
+                char    _hex[27];
+                store_hex( _hex );
+                j = _hex;
+                return;
+            }
+            break;
+        case Wire::PACKED:
+            {
+                std::uint8_t    _bytes[PACKED + OUTMASK];
+                j = to_base64( _bytes, store_packed( _bytes ) - _bytes );
+                return;
+            }
+        default:
+            break;
+        }
+        j = deck_;
+    }
+
+    void
+    Deck::fr_js( nlohmann::json const& j )
+    {
+        if ( !j.is_string() ) { j.get_to( deck_ ); return; }
+
+        std::string const&  _text(j.get_ref<std::string const&>());
+        std::uint8_t        _bytes[PACKED + OUTMASK];
+        bool const          _ok{_text.size() == 26
+                              ? load_hex( _text.c_str() )
+                              : load_packed( _bytes, fr_base64( _bytes, sizeof _bytes, _text ) )};
+        if ( !_ok ) { throw std::invalid_argument( "not a deck: " + _text ); }
+    }
+
+    std::vector<std::uint8_t>
+    Deck::to_bin( Wire wire, Binary bin ) const
+    {
+        nlohmann::json  _js;
+        to_js( _js, wire );
+        return bin == Binary::CBOR ? nlohmann::json::to_cbor( _js ) : nlohmann::json::to_msgpack( _js );
+    }
+
+    bool
+    Deck::fr_bin( std::vector<std::uint8_t> const& bytes, Binary bin )
+    {
+        try
+        {
+            fr_js( bin == Binary::CBOR ? nlohmann::json::from_cbor( bytes ) : nlohmann::json::from_msgpack( bytes ) );
+            return true;
         }
+        catch ( std::exception const& ) { return false; }
     }
@@ -10,6 +10,8 @@
 
 #include "nlohmann/json.hpp"
 #include <array>
+#include <cstdint>
+#include <vector>
 
     /**
      * locations of all cards in a std::array<int, 52>, using
@@ -21,6 +23,16 @@
         enum { DECKSIZE = 52 };
     public:
         enum class Format : int { HEX, LIN, PBN, BHG };
+        /**
+         * JSON forms of the layout:
+         * - ARRAY  the 52 seats, [2,3,2,...]
+         * - HEX    the 26-char hex string (full deals; else as ARRAY)
+         * - PACKED 13 bytes, 2 bits a card (S W N E), then 7 bytes of out of
+         *          play cards if any, as base64: 20 or 28 chars
+         * fr_js() takes any of them.
+         */
+        enum class Wire : int { ARRAY, HEX, PACKED };
+        enum class Binary : int { CBOR, MSGPACK };
         ~Deck() noexcept = default;
         //
         Deck() = default;
@@ -48,10 +60,20 @@
         int const* end() const { return deck_.end(); }
         //
         void to_js( nlohmann::json& j ) const { j = deck_; }
-        void fr_js( nlohmann::json const& j ) { j.get_to( deck_ ); }
+        void to_js( nlohmann::json& j, Wire ) const;
+        //!> throws std::invalid_argument for a string that is none of the forms
+        void fr_js( nlohmann::json const& j );
         //
         void to_js( nlohmann::json& j, char const* key ) const { j[key] = deck_; }
-        void fr_js( nlohmann::json const& j, char const* key) { j.at( key ).get_to( deck_ ); }
+        void to_js( nlohmann::json& j, char const* key, Wire wire ) const { to_js( j[key], wire ); }
+        void fr_js( nlohmann::json const& j, char const* key) { fr_js( j.at( key ) ); }
+        //!> the JSON form in CBOR or MessagePack
+        std::vector<std::uint8_t> to_bin( Wire, Binary ) const;
+        bool fr_bin( std::vector<std::uint8_t> const&, Binary );
+        //
+        //!> the PACKED bytes (13, or 20 with cards out of play); returns the end
+        std::uint8_t* store_packed( std::uint8_t* ) const;
+        bool load_packed( std::uint8_t const*, std::size_t len );
         static bool verify_hex( char const* );
         int count( int = 0 ) const;
         //needs a 4-array (at least) passed in for point counts
@@ -0,0 +1,464 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "FeatureIndex.h"
+#include "DealArchive.h"
+#include "Deck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <ctype.h>
+#include <errno.h>
+
+namespace
+{
+    char const      featureMagic[8] = { 'B', 'R', 'I', 'D', 'G', 'E', 'F', 'X' };
+    std::uint32_t   featureVersion{1};
+
+    struct Header
+    {
+        char            magic[8];
+        std::uint32_t   version;
+        std::uint32_t   lists;
+        std::uint64_t   count;      //!< deals
+        std::uint64_t   chunks;
+        std::uint64_t   words;      //!< list data, after the directory
+        std::uint64_t   pad[3];
+    };
+    static_assert( sizeof(Header) == 64, "feature index header" );
+
+    //!> the 39 patterns longest first, in descending order: 13000 .. 4333
+    std::array<int, FeatureIndex::PATTERNS> make_patterns()
+    {
+        std::array<int, FeatureIndex::PATTERNS> _patterns;
+        int _count{0};
+        for ( int _a{13}; _a >= 4; --_a )
+            for ( int _b{std::min( _a, 13 - _a )}; _b >= 0; --_b )
+                for ( int _c{std::min( _b, 13 - _a - _b )}; _c >= 0; --_c )
+                {
+                    int const   _d{13 - _a - _b - _c};
+                    if ( _d <= _c ) { _patterns[_count++] = ((_a * 10 + _b) * 10 + _c) * 10 + _d; }
+                }
+        return _patterns;
+    }
+
+    std::array<int, FeatureIndex::PATTERNS> const   patterns = make_patterns();
+
+    //!> pattern id by the three longest lengths, 196 * a + 14 * b + c
+    std::array<signed char, 14 * 14 * 14> make_pattern_ids()
+    {
+        std::array<signed char, 14 * 14 * 14>   _ids;
+        _ids.fill( -1 );
+        for ( int _id{0}; _id < FeatureIndex::PATTERNS; ++_id )
+        {
+            int const   _p{patterns[_id]};
+            _ids[196 * (_p / 1000) + 14 * (_p / 100 % 10) + _p / 10 % 10] = static_cast<signed char>(_id);
+        }
+        return _ids;
+    }
+
+    //!> N, N-M, N+ or -M, within 0..max
+    bool to_range( std::string const& text, int max, int& lo, int& hi )
+    {
+        char const* _ptr{text.c_str()};
+        char*       _end;
+        lo = 0;
+        hi = max;
+        if ( *_ptr == '-' )
+        {
+            hi = static_cast<int>(std::strtol( _ptr + 1, &_end, 10 ));
+            if ( _end == _ptr + 1 ) { return false; }
+        }
+        else
+        {
+            lo = static_cast<int>(std::strtol( _ptr, &_end, 10 ));
+            if ( _end == _ptr ) { return false; }
+            if ( *_end == '+' ) { ++_end; }
+            else if ( *_end == '-' )
+            {
+                _ptr = _end + 1;
+                hi = static_cast<int>(std::strtol( _ptr, &_end, 10 ));
+                if ( _end == _ptr ) { return false; }
+            }
+            else { hi = lo; }
+        }
+        return *_end == '\0' && lo >= 0 && lo <= hi && hi <= max;
+    }
+
+    std::uint64_t span( int lo, int hi ) { return (~0ull >> (63 - hi)) & (~0ull << lo); }
+
+    std::vector<std::string> split( std::string const& text, char sep )
+    {
+        std::vector<std::string>    _parts;
+        std::istringstream          _in(text);
+        for ( std::string _part; std::getline( _in, _part, sep ); ) { _parts.push_back( _part ); }
+        return _parts;
+    }
+
+    //!> SA, HK, DQ, CJ to 0..15, -1 if not an honor
+    int to_honor( std::string const& card )
+    {
+        static char const   suits[] = "SHDC";
+        static char const   ranks[] = "AKQJ";
+        if ( card.size() != 2 ) { return -1; }
+        char const* _suit = std::strchr( suits, ::toupper( card[0] ) );
+        char const* _rank = std::strchr( ranks, ::toupper( card[1] ) );
+        if ( !_suit || !_rank || !*_suit || !*_rank ) { return -1; }
+        return 4 * static_cast<int>(_suit - suits) + static_cast<int>(_rank - ranks);
+    }
+
+    //!> one chunk's lists onto 'words', as (offset, count) pairs onto 'dir'; offsets start at 'base'
+    void emit( std::vector<std::vector<std::uint16_t>> const& lists, std::size_t base,
+               std::vector<std::uint64_t>& words, std::vector<std::uint32_t>& dir )
+    {
+        for ( auto const& _list : lists )
+        {
+            std::size_t const   _at{words.size()};
+            std::uint32_t const _count{static_cast<std::uint32_t>(_list.size())};
+            if ( _count > FeatureIndex::SPARSE )
+            {
+                words.resize( _at + FeatureIndex::WORDS, 0 );
+                for ( std::uint16_t _deal : _list ) { words[_at + (_deal >> 6)] |= 1ull << (_deal & 63); }
+            }
+            else
+            {
+                words.resize( _at + (_count + 3) / 4, 0 );
+                std::memcpy( words.data() + _at, _list.data(), _count * sizeof(std::uint16_t) );
+            }
+            dir.push_back( static_cast<std::uint32_t>(base + _at) );
+            dir.push_back( _count );
+        }
+    }
+}
+
+    /* static */ int
+    FeatureIndex::pattern_id( int pattern )
+    {
+        auto const  _where(std::find( patterns.begin(), patterns.end(), pattern ));
+        return _where == patterns.end() ? -1 : static_cast<int>(_where - patterns.begin());
+    }
+
+    // ----------------------------------------------------------------- Query
+
+    FeatureIndex::Query::Query(char const* spec)
+    {
+        int     _clause{0};
+        for ( auto const& _text : split( spec ? spec : "", ';' ) )
+        {
+            ++_clause;
+            std::string::size_type const    _colon{_text.find( ':' )};
+            std::istringstream              _head(_text.substr( 0, _colon ));
+            std::string                     _who;
+            _head >> _who;
+            if ( _colon == std::string::npos && _who.empty() ) { continue; } // empty clause
+            std::transform( _who.begin(), _who.end(), _who.begin(), ::toupper );
+            if ( _colon == std::string::npos || _who.size() != 1 || !std::strchr( "WNES", _who[0] ) )
+            {
+                fail_( "clause " + std::to_string( _clause ) + ": expected W:, N:, E: or S:" );
+                return;
+            }
+            int const   _seat{static_cast<int>(std::strchr( "WNES", _who[0] ) - "WNES") + 1};
+
+            std::istringstream  _terms(_text.substr( _colon + 1 ));
+            for ( std::string _term; _terms >> _term; )
+            {
+                std::string::size_type const    _eq{_term.find( '=' )};
+                std::string     _key{_term.substr( 0, _eq )};
+                std::string     _value{_eq == std::string::npos ? "" : _term.substr( _eq + 1 )};
+                std::transform( _key.begin(), _key.end(), _key.begin(), ::tolower );
+                std::string const   _bad{"clause " + std::to_string( _clause ) + ": bad term '" + _term + "'"};
+                int     _lo, _hi;
+
+                if ( (_key == "bal" || _key == "unbal") && _eq == std::string::npos )
+                {
+                    std::uint64_t const _bal{1ull << pattern_id( 4333 ) | 1ull << pattern_id( 4432 ) | 1ull << pattern_id( 5332 )};
+                    terms_.push_back( Term{pattern( _seat, 0 ), PATTERNS, _bal, true, _key == "unbal"} );
+                    continue;
+                }
+                if ( _eq == std::string::npos ) { fail_( _bad ); return; }
+
+                char const* _suit{_key.size() == 1 ? std::strchr( "shdc", _key[0] ) : nullptr};
+                if ( _key == "hcp" && to_range( _value, 37, _lo, _hi ) )
+                {
+                    terms_.push_back( Term{hcp( _seat, 0 ), 38, span( _lo, _hi ), true, false} );
+                }
+                else if ( _suit && *_suit && to_range( _value, 13, _lo, _hi ) )
+                {
+                    terms_.push_back( Term{length( _seat, static_cast<int>(_suit - "shdc"), 0 ), 14, span( _lo, _hi ), true, false} );
+                }
+                else if ( _key == "shape" )
+                {
+                    std::uint64_t   _values{0};
+                    for ( auto const& _item : split( _value, ',' ) )
+                    {
+                        if ( _item == "bal" )
+                        {
+                            _values |= 1ull << pattern_id( 4333 ) | 1ull << pattern_id( 4432 ) | 1ull << pattern_id( 5332 );
+                            continue;
+                        }
+                        if ( _item == "unbal" )
+                        {
+                            _values |= ((1ull << PATTERNS) - 1) & ~(1ull << pattern_id( 4333 ) | 1ull << pattern_id( 4432 ) | 1ull << pattern_id( 5332 ));
+                            continue;
+                        }
+                        if ( _item.size() != 4 || !std::all_of( _item.begin(), _item.end(), ::isdigit ) ) { fail_( _bad ); return; }
+                        std::array<int, 4>  _len{{_item[0] - '0', _item[1] - '0', _item[2] - '0', _item[3] - '0'}};
+                        if ( _len[0] + _len[1] + _len[2] + _len[3] != 13 ) { fail_( _bad ); return; }
+                        std::sort( _len.begin(), _len.end(), []( int a, int b ) { return a > b; } );
+                        _values |= 1ull << pattern_id( ((_len[0] * 10 + _len[1]) * 10 + _len[2]) * 10 + _len[3] );
+                    }
+                    if ( !_values ) { fail_( _bad ); return; }
+                    terms_.push_back( Term{pattern( _seat, 0 ), PATTERNS, _values, true, false} );
+                }
+                else if ( _key == "has" || _key == "not" )
+                {
+                    for ( auto const& _card : split( _value, ',' ) )
+                    {
+                        int const   _honor{to_honor( _card )};
+                        if ( _honor < 0 ) { fail_( _bad + " (only A K Q J are indexed)" ); return; }
+                        terms_.push_back( Term{honor( _seat, _honor ), 1, 1, false, _key == "not"} );
+                    }
+                }
+                else { fail_( _bad ); return; }
+            }
+        }
+    }
+
+    bool
+    FeatureIndex::Query::fail_( std::string const& why )
+    {
+        error_ = why;
+        terms_.clear();
+        return false;
+    }
+
+    // ----------------------------------------------------------------- index
+
+    FeatureIndex::FeatureIndex()
+    : pending_(LISTS)
+    {}
+
+    bool
+    FeatureIndex::add( Bitboard const& deal )
+    {
+        static std::array<signed char, 14 * 14 * 14> const  ids = make_pattern_ids();
+        if ( file_ || !deal.complete() ) { return false; }
+
+        std::uint16_t const _deal{static_cast<std::uint16_t>(count_ % CHUNK)};
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            Bitboard::Shape const   _pattern(deal.pattern( _seat ));
+            pending_[hcp( _seat, deal.hcp( _seat ) )].push_back( _deal );
+            pending_[pattern( _seat, ids[196 * _pattern[0] + 14 * _pattern[1] + _pattern[2]] )].push_back( _deal );
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                pending_[length( _seat, _suit, deal.length( _seat, _suit ) )].push_back( _deal );
+            }
+            // A K Q J are the top four bits of each suit lane
+            Bitboard::Mask const    _hand{deal.hand( _seat )};
+            for ( int _honor{0}; _honor < HONORS; ++_honor )
+            {
+                if ( _hand >> (16 * (_honor / 4) + 12 - _honor % 4) & 1 ) { pending_[honor( _seat, _honor )].push_back( _deal ); }
+            }
+        }
+        if ( ++count_ % CHUNK == 0 ) { seal_(); }
+        return true;
+    }
+
+    std::size_t
+    FeatureIndex::load( ArchiveReader const& arc )
+    {
+        std::size_t const   _before{count_};
+        Deck                _deck;
+        for ( auto const& _entry : arc )
+        {
+            // deal numbers are record positions, so a gap would shift the rest
+            if ( !_entry.load( _deck ) || !add( Bitboard(_deck) ) ) { break; }
+        }
+        return count_ - _before;
+    }
+
+    // the open chunk, now full, moves into the directory
+    void
+    FeatureIndex::seal_()
+    {
+        std::vector<std::uint32_t>  _dir;
+        emit( pending_, 0, words_, _dir );
+        std::size_t const   _at{dir_.size()};
+        dir_.resize( _at + LISTS );
+        std::memcpy( dir_.data() + _at, _dir.data(), _dir.size() * sizeof(std::uint32_t) );
+        for ( auto& _list : pending_ ) { _list.clear(); }
+        ++chunks_;
+        slots_      = dir_.data();
+        data_       = words_.data();
+        words_size_ = words_.size();
+    }
+
+    // the term's deals in a chunk; the open chunk is read from its pending lists
+    void
+    FeatureIndex::gather_( std::size_t chunk, Query::Term const& term, Block& block ) const
+    {
+        std::size_t const   _deals{std::min<std::size_t>( CHUNK, count_ - chunk * CHUNK )};
+        bool const          _open{chunk == chunks_};
+        auto    _size([&]( int list ) -> std::size_t
+        {
+            return _open ? pending_[list].size() : slots_[chunk * LISTS + list].count;
+        });
+
+        // the values given, or the rest of a partition if they are fewer deals
+        std::uint64_t   _values{term.values};
+        bool            _invert{term.negate};
+        if ( term.partition )
+        {
+            std::size_t _in{0};
+            for ( int _ndx{0}; _ndx < term.size; ++_ndx ) { _in += _values >> _ndx & 1 ? _size( term.base + _ndx ) : 0; }
+            if ( 2 * _in > _deals )
+            {
+                _values = ~_values & span( 0, term.size - 1 );
+                _invert = !_invert;
+            }
+        }
+
+        block.fill( 0 );
+        for ( ; _values; _values &= _values - 1 )
+        {
+            int const   _list{term.base + __builtin_ctzll( _values )};
+            if ( _open )
+            {
+                for ( std::uint16_t _deal : pending_[_list] ) { block[_deal >> 6] |= 1ull << (_deal & 63); }
+                continue;
+            }
+            Slot const&             _slot(slots_[chunk * LISTS + _list]);
+            std::uint64_t const*    _words{data_ + _slot.offset};
+            if ( _slot.count > SPARSE )
+            {
+                for ( int _ndx{0}; _ndx < WORDS; ++_ndx ) { block[_ndx] |= _words[_ndx]; }
+            }
+            else
+            {
+                std::uint16_t const*    _deal{reinterpret_cast<std::uint16_t const*>(_words)};
+                for ( std::uint32_t _ndx{0}; _ndx < _slot.count; ++_ndx ) { block[_deal[_ndx] >> 6] |= 1ull << (_deal[_ndx] & 63); }
+            }
+        }
+        if ( _invert )
+        {
+            for ( auto& _word : block ) { _word = ~_word; }
+            // no deals past the end of a partial chunk
+            if ( _deals < CHUNK )
+            {
+                if ( _deals % 64 ) { block[_deals / 64] &= ~0ull >> (64 - _deals % 64); }
+                std::fill( block.begin() + (_deals + 63) / 64, block.end(), 0 );
+            }
+        }
+    }
+
+    std::size_t
+    FeatureIndex::match( Query const& query, std::vector<std::uint64_t>* out ) const
+    {
+        if ( !query ) { return 0; }
+        std::size_t     _found{0};
+        Block           _result, _term;
+        std::size_t const   _chunks{(count_ + CHUNK - 1) / CHUNK};
+        for ( std::size_t _chunk{0}; _chunk < _chunks; ++_chunk )
+        {
+            std::size_t const   _deals{std::min<std::size_t>( CHUNK, count_ - _chunk * CHUNK )};
+            if ( query.terms_.empty() )
+            {
+                _result.fill( 0 );
+                for ( std::size_t _ndx{0}; _ndx < _deals; ++_ndx ) { _result[_ndx >> 6] |= 1ull << (_ndx & 63); }
+            }
+            bool    _any{true};
+            for ( std::size_t _ndx{0}; _ndx < query.terms_.size() && _any; ++_ndx )
+            {
+                gather_( _chunk, query.terms_[_ndx], _ndx ? _term : _result );
+                if ( _ndx == 0 ) { continue; }
+                std::uint64_t   _seen{0};
+                for ( int _word{0}; _word < WORDS; ++_word ) { _seen |= (_result[_word] &= _term[_word]); }
+                _any = _seen != 0;
+            }
+            if ( !_any ) { continue; }
+
+            for ( int _word{0}; _word < WORDS; ++_word )
+            {
+                _found += Bitboard::popcount( _result[_word] );
+                if ( !out ) { continue; }
+                for ( std::uint64_t _bits{_result[_word]}; _bits; _bits &= _bits - 1 )
+                {
+                    out->push_back( _chunk * CHUNK + 64 * _word + __builtin_ctzll( _bits ) );
+                }
+            }
+        }
+        return _found;
+    }
+
+    bool
+    FeatureIndex::save( char const* file )
+    {
+        // the open chunk goes out as a last, partial one
+        std::vector<std::uint32_t>  _tail;
+        std::vector<std::uint64_t>  _extra;
+        if ( count_ % CHUNK != 0 && !file_ ) { emit( pending_, words_size_, _extra, _tail ); }
+
+        Header  _head{};
+        std::memcpy( _head.magic, featureMagic, sizeof _head.magic );
+        _head.version = featureVersion;
+        _head.lists   = LISTS;
+        _head.count   = count_;
+        _head.chunks  = (count_ + CHUNK - 1) / CHUNK;
+        _head.words   = words_size_ + _extra.size();
+
+        // by way of a temporary, since the file may be the one mapped
+        std::string const   _temp{std::string(file) + ".tmp"};
+        std::FILE*          _fp{std::fopen( _temp.c_str(), "wb" )};
+        if ( !_fp ) { err_ = errno; return false; }
+        err_ = 0;
+        std::size_t const   _sealed{chunks_ * LISTS};
+        if ( std::fwrite( &_head, sizeof _head, 1, _fp ) != 1
+          || std::fwrite( slots_, sizeof(Slot), _sealed, _fp ) != _sealed
+          || std::fwrite( _tail.data(), sizeof(std::uint32_t), _tail.size(), _fp ) != _tail.size()
+          || std::fwrite( data_, sizeof(std::uint64_t), words_size_, _fp ) != words_size_
+          || std::fwrite( _extra.data(), sizeof(std::uint64_t), _extra.size(), _fp ) != _extra.size() )
+        {
+            err_ = errno;
+        }
+        if ( std::fclose( _fp ) != 0 && err_ == 0 ) { err_ = errno; }
+        if ( err_ == 0 && std::rename( _temp.c_str(), file ) != 0 ) { err_ = errno; }
+        if ( err_ != 0 ) { std::remove( _temp.c_str() ); }
+        return err_ == 0;
+    }
+
+    bool
+    FeatureIndex::open( char const* file )
+    {
+        std::unique_ptr<Utility::StrFile>   _file(new Utility::StrFile(file));
+        if ( !*_file ) { err_ = _file->error(); return false; }
+
+        auto const* _head(reinterpret_cast<Header const*>(_file->get()));
+        if ( _file->size() < sizeof *_head
+          || std::memcmp( _head->magic, featureMagic, sizeof _head->magic ) != 0
+          || _head->version != featureVersion
+          || _head->lists != LISTS
+          || _head->chunks != (_head->count + CHUNK - 1) / CHUNK
+          || _file->size() < sizeof *_head + _head->chunks * LISTS * sizeof(Slot) + _head->words * sizeof(std::uint64_t) )
+        {
+            err_ = EINVAL;
+            return false;
+        }
+        slots_  = reinterpret_cast<Slot const*>(_file->get() + sizeof *_head);
+        data_   = reinterpret_cast<std::uint64_t const*>(slots_ + _head->chunks * LISTS);
+        chunks_ = _head->chunks;
+        count_  = _head->count;
+        words_size_ = _head->words;
+        file_   = std::move( _file );
+        dir_    = std::vector<Slot>();
+        words_  = std::vector<std::uint64_t>();
+        for ( auto& _list : pending_ ) { _list.clear(); }
+        err_    = 0;
+        return true;
+    }
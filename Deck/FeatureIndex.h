@@ -0,0 +1,139 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_FEATUREINDEX_H
+#define BRIDGE_FEATUREINDEX_H
+
+#include "Bitboard.h"
+#include "StrFile.h"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ArchiveReader;
+
+    /**
+     * @class FeatureIndex
+     * @brief Inverted index over hand features of numbered deals.
+     * For each seat there is a list of the deals with each point count
+     * (0..37), each length of each suit (0..13), each pattern (e.g. 5431,
+     * 39 in all) and each of the sixteen honors (A K Q J of SHDC) held.
+     * Deals are taken in chunks of 65536; a list's part in a chunk is
+     * a sorted array of 16-bit offsets when short, otherwise a 1024-word
+     * bitmap (as in Roaring bitmaps), so sparse lists cost little.
+     *
+     * A query runs chunk by chunk: each term ORs its lists into a bitmap
+     * (or the complement of the rest, if that is fewer deals) which is
+     * ANDed into the result, stopping at the first empty one.
+     *
+     * The file form is a 64-byte header, the directory (offset and size
+     * of every list in every chunk) and the lists, so open() maps it and
+     * is ready at once; an opened index takes no more deals.
+     */
+    class FeatureIndex
+    {
+    public:
+        enum { CHUNK = 1 << 16, WORDS = CHUNK / 64, SPARSE = 4096 };
+        enum { PATTERNS = 39, HONORS = 16 };
+        //!> list numbers: a seat's lists of each kind are together
+        enum
+        {
+            HCP     = 0,
+            LENGTH  = HCP + 4 * 38,
+            PATTERN = LENGTH + 4 * 4 * 14,
+            HONOR   = PATTERN + 4 * PATTERNS,
+            LISTS   = HONOR + 4 * HONORS
+        };
+
+        /**
+         * @class Query
+         * @brief The seat clauses of a DealFilter spec (see Constraint.h):
+         * hcp=R, s= h= d= c=R, shape=, bal, unbal and has= / not= for the
+         * honors A K Q J. Side clauses (NS: EW:) are not indexed.
+         */
+        class Query
+        {
+        public:
+            explicit
+            Query(char const* spec);
+
+            explicit operator bool() const { return error_.empty(); }
+            std::string const& error() const { return error_; }
+
+        private:
+            friend class FeatureIndex;
+
+            //!> values of one kind of list; a partition covers every deal once
+            struct Term
+            {
+                int             base;
+                int             size;
+                std::uint64_t   values;     //!< bit n: list base + n
+                bool            partition;
+                bool            negate;
+            };
+            std::vector<Term>   terms_;
+            std::string         error_;
+
+            bool fail_( std::string const& );
+        };
+
+        ~FeatureIndex() noexcept = default;
+        FeatureIndex();
+
+        std::size_t size() const { return count_; }
+
+        //!> the next deal number; false for an incomplete deal or an opened index
+        bool add( Bitboard const& );
+        //!> the records of an archive, in order, up to the first that is not a full deal; returns the number added
+        std::size_t load( ArchiveReader const& );
+
+        //!> number of matching deals; their numbers are appended to 'out', if given
+        std::size_t match( Query const&, std::vector<std::uint64_t>* out = nullptr ) const;
+
+        //!> the file form; open() replaces the contents, false (errno in error()) on failure
+        bool save( char const* file );
+        bool open( char const* file );
+        int error() const { return err_; }
+
+        static int hcp( int seat, int points ) { return HCP + 38 * (seat - 1) + points; }
+        static int length( int seat, int suit, int len ) { return LENGTH + 14 * (4 * (seat - 1) + suit) + len; }
+        static int pattern( int seat, int id ) { return PATTERN + PATTERNS * (seat - 1) + id; }
+        //!> honor 0..15: A K Q J of spades, then hearts ...
+        static int honor( int seat, int honor ) { return HONOR + HONORS * (seat - 1) + honor; }
+        //!> 0..38 for a pattern written longest first (e.g. 5431), -1 if none
+        static int pattern_id( int pattern );
+
+    private:
+        struct Slot
+        {
+            std::uint32_t   offset;     //!< in words
+            std::uint32_t   count;      //!< deals; above SPARSE the list is a bitmap
+        };
+        static_assert( sizeof(Slot) == 8, "feature slot" );
+        using Block = std::array<std::uint64_t, WORDS>;
+
+        std::unique_ptr<Utility::StrFile>   file_;  //!< when opened
+        std::vector<Slot>           dir_;           //!< owned: [chunk][list]
+        std::vector<std::uint64_t>  words_;
+        Slot const*                 slots_{nullptr};
+        std::uint64_t const*        data_{nullptr};
+        std::size_t                 words_size_{0}; //!< in data_
+        std::size_t                 chunks_{0};     //!< sealed, the last one maybe partial
+        std::size_t                 count_{0};
+        std::vector<std::vector<std::uint16_t>> pending_;   //!< the open chunk
+        int                         err_{0};
+
+        void seal_();
+        void gather_( std::size_t chunk, Query::Term const&, Block& ) const;
+    };
+
+#endif // BRIDGE_FEATUREINDEX_H
@@ -0,0 +1,280 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "Generator.h"
+#include "Constraint.h"
+#include "DealArchive.h"
+#include "DealIndex.h"
+#include "CharBuffer.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+    /**
+     * GenDeals: reproducible random deals.
+     *   GenDeals [-s seed] [-f first] [-n count] [-t hex|pbn|lin] [-j threads]
+     *   GenDeals ... -o file.arc [-r]    write a binary archive instead
+     *   GenDeals ... -c spec [-m max]    only deals meeting spec (see Constraint.h)
+     *   GenDeals ... -x file.idx         never a deal in the index (see DealIdx)
+     *   GenDeals ... -b                  benchmark only
+     * Board b of seed s is always the same deal. With -c the output is
+     * the first count matches among boards first, first + 1, ...
+     * numbered consecutively; -m caps the boards scanned. Deals found in
+     * the -x index are skipped in the same way.
+     */
+
+namespace
+{
+    enum { BATCH = 1 << 16 };
+
+    struct Options
+    {
+        std::uint64_t   seed{0};
+        std::uint64_t   first{1};
+        std::size_t     count{16};
+        unsigned        threads{0};
+        Deck::Format    fmt{Deck::Format::HEX};
+        char const*     archive{nullptr};
+        DealFilter*     filter{nullptr};
+        DealIndex*      played{nullptr};
+        std::uint64_t   limit{0};
+        bool            rank{false};
+        bool            bench{false};
+    };
+
+    //!> drops the deals already played, keeping the order of the rest
+    std::size_t drop_played( Options const& opts, std::vector<Deck>& decks, std::size_t count )
+    {
+        if ( !opts.played ) { return count; }
+        std::size_t _kept{0};
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            if ( opts.played->contains( decks[_ndx] ) ) { continue; }
+            if ( _kept != _ndx ) { decks[_kept] = decks[_ndx]; }
+            ++_kept;
+        }
+        return _kept;
+    }
+
+    /**
+     * Next batch of output deals: boards next, next + 1, ... or, with a
+     * filter, the matches among them. Advances next past what was used.
+     */
+    std::size_t next_batch( Options const& opts, DealGenerator const& gen, std::uint64_t& next,
+                            std::vector<Deck>& decks, std::size_t want )
+    {
+        if ( !opts.filter )
+        {
+            gen.deal( decks.data(), next, want, opts.threads );
+            next += want;
+            return want;
+        }
+        std::vector<DealFilter::Match>  _matches;
+        std::uint64_t   _max{0};
+        if ( opts.limit )
+        {
+            if ( next - opts.first >= opts.limit ) { return 0; }
+            _max = opts.limit - (next - opts.first);
+        }
+        next += opts.filter->search( gen, next, want, _matches, opts.threads, _max );
+        for ( std::size_t _ndx{0}; _ndx < _matches.size(); ++_ndx ) { _matches[_ndx].deal.to_deck( decks[_ndx] ); }
+        return _matches.size();
+    }
+
+    //!> the next batch less any deals already played; 0 only when no boards are left
+    std::size_t fill( Options const& opts, DealGenerator const& gen, std::uint64_t& next,
+                      std::vector<Deck>& decks, std::size_t want )
+    {
+        for ( ;; )
+        {
+            std::uint64_t const _from{next};
+            std::size_t const   _kept{drop_played( opts, decks, next_batch( opts, gen, next, decks, want ) )};
+            if ( _kept || next == _from ) { return _kept; }
+        }
+    }
+}
+
+int write_text( Options const& opts )
+{
+    DealGenerator       _gen(opts.seed);
+    std::vector<Deck>   _decks(std::min<std::size_t>( opts.count, BATCH ));
+    std::string         _out;
+    std::uint64_t       _next{opts.first};
+
+    for ( std::size_t _done{0}; _done < opts.count; )
+    {
+        std::size_t const   _batch{fill( opts, _gen, _next, _decks, std::min<std::size_t>( opts.count - _done, BATCH ) )};
+        if ( _batch == 0 ) { break; }
+        _out.clear();
+        for ( std::size_t _ndx{0}; _ndx < _batch; ++_ndx )
+        {
+            Buffer128       _line;
+            int const       _dlr(static_cast<int>((opts.first + _done + _ndx) % 4) + 1); // board 1: North
+            switch ( opts.fmt )
+            {
+            case Deck::Format::PBN: _decks[_ndx].store_pbn_s( _line.get(), 128, _dlr ); break;
+            case Deck::Format::LIN: _decks[_ndx].store_lin_s( _line.get(), 128, _dlr ); break;
+            case Deck::Format::BHG: _decks[_ndx].store_bhg( _line.get(), 128, 2 ); break;
+            default:                _decks[_ndx].store_hex( _line.get(), 128 ); break;
+            }
+            _out.append( _line.get() ).push_back( '\n' );
+        }
+        if ( std::fwrite( _out.data(), 1, _out.size(), stdout ) != _out.size() )
+        {
+            std::cerr << "Write error: " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        _done += _batch;
+    }
+    std::fflush( stdout );
+    if ( opts.filter ) { std::cerr << (_next - opts.first) << " boards scanned\n"; }
+    return 0;
+}
+
+int write_archive( Options const& opts )
+{
+    DealGenerator       _gen(opts.seed);
+    ArchiveWriter       _arc(opts.archive, opts.rank ? DealArchive::Format::RANK : DealArchive::Format::HEX);
+    std::vector<Deck>   _decks(std::min<std::size_t>( opts.count, BATCH ));
+    std::uint64_t       _next{opts.first};
+
+    for ( std::size_t _done{0}; _arc && _done < opts.count; )
+    {
+        std::size_t const   _batch{fill( opts, _gen, _next, _decks, std::min<std::size_t>( opts.count - _done, BATCH ) )};
+        if ( _batch == 0 ) { break; }
+        for ( std::size_t _ndx{0}; _ndx < _batch; ++_ndx )
+        {
+            _arc.add( _decks[_ndx], static_cast<int>(opts.first + _done + _ndx) );
+        }
+        _done += _batch;
+    }
+    if ( !_arc.close() )
+    {
+        std::cerr << "Error writing " << opts.archive << ": " << ::strerror( _arc.error() ) << "\n";
+        return 1;
+    }
+    std::cerr << _arc.size() << " records\n";
+    return 0;
+}
+
+int bench_filter( Options const& opts )
+{
+    using Clock = std::chrono::steady_clock;
+    DealGenerator                   _gen(opts.seed);
+    std::vector<DealFilter::Match>  _matches;
+    unsigned const                  _threads{opts.threads ? opts.threads : 1};
+
+    auto const  _t0(Clock::now());
+    std::uint64_t const _scanned{opts.filter->search( _gen, opts.first, opts.count, _matches, _threads, opts.limit )};
+    double const _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    // sanity: the filter accepts what it returned
+    Bitboard    _check;
+    bool const  _same{_matches.empty() || (*opts.filter)( _gen.deal( _check, _matches.back().board ) )};
+
+    std::cout << "matches: " << _matches.size() << " of " << _scanned << " boards, threads: " << _threads
+              << " seconds: " << _secs << "\n"
+              << "boards/sec: " << (_scanned / _secs)
+              << " per core: " << (_scanned / _secs / _threads)
+              << " matches/sec: " << (_matches.size() / _secs)
+              << (_same ? "" : "  (MISMATCH)") << std::endl;
+    return _same ? 0 : 1;
+}
+
+int benchmark( Options const& opts )
+{
+    using Clock = std::chrono::steady_clock;
+    DealGenerator       _gen(opts.seed);
+    std::vector<Deck>   _decks(opts.count);
+    unsigned const      _threads{opts.threads ? opts.threads : 1};
+
+    auto const  _t0(Clock::now());
+    _gen.deal( _decks.data(), opts.first, opts.count, _threads );
+    double const _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    // sanity: every board can be regenerated on its own
+    Deck        _check;
+    bool const  _same{std::equal( _decks.back().begin(), _decks.back().end(),
+                                  _gen.deal( _check, opts.first + opts.count - 1 ).begin() )};
+
+    std::cout << "deals: " << opts.count << " threads: " << _threads
+              << " seconds: " << _secs << "\n"
+              << "deals/sec: " << (opts.count / _secs)
+              << " per core: " << (opts.count / _secs / _threads)
+              << (_same ? "" : "  (MISMATCH)") << std::endl;
+    return _same ? 0 : 1;
+}
+
+int main( int ac, char* av[] )
+{
+    Options     _opts;
+    char const* _spec{nullptr};
+    int         _opt;
+
+    char const* _played{nullptr};
+
+    while ( (_opt = ::getopt( ac, av, "s:f:n:t:j:o:rbc:m:x:" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 's': _opts.seed    = std::strtoull( ::optarg, nullptr, 0 ); break;
+        case 'f': _opts.first   = std::strtoull( ::optarg, nullptr, 10 ); break;
+        case 'n': _opts.count   = std::strtoull( ::optarg, nullptr, 10 ); break;
+        case 'j': _opts.threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'o': _opts.archive = ::optarg; break;
+        case 'r': _opts.rank    = true; break;
+        case 'b': _opts.bench   = true; break;
+        case 'c': _spec         = ::optarg; break;
+        case 'm': _opts.limit   = std::strtoull( ::optarg, nullptr, 10 ); break;
+        case 'x': _played       = ::optarg; break;
+        case 't':
+            if      ( !::strcasecmp( ::optarg, "pbn" ) ) { _opts.fmt = Deck::Format::PBN; }
+            else if ( !::strcasecmp( ::optarg, "lin" ) ) { _opts.fmt = Deck::Format::LIN; }
+            else if ( !::strcasecmp( ::optarg, "bhg" ) ) { _opts.fmt = Deck::Format::BHG; }
+            else if ( !::strcasecmp( ::optarg, "hex" ) ) { _opts.fmt = Deck::Format::HEX; }
+            else { std::cerr << "Unknown format: " << ::optarg << "\n"; return 2; }
+            break;
+        default:
+            std::cerr << "Usage: " << av[0] << " [-s seed] [-f first] [-n count] [-t hex|pbn|lin|bhg] [-j threads] [-o file.arc [-r]] [-c spec [-m max]] [-x file.idx] [-b]\n";
+            return 2;
+        }
+    }
+    if ( _opts.count == 0 ) { return 0; }
+
+    DealIndex   _index;
+    if ( _played )
+    {
+        if ( !_index.open( _played ) )
+        {
+            std::cerr << "Cannot read " << _played << ": " << ::strerror( _index.error() ) << "\n";
+            return 1;
+        }
+        _opts.played = &_index;
+    }
+
+    std::unique_ptr<DealFilter> _filter;
+    if ( _spec )
+    {
+        _filter.reset( new DealFilter(_spec) );
+        if ( !*_filter )
+        {
+            std::cerr << "Bad constraint: " << _filter->error() << "\n";
+            return 2;
+        }
+        _opts.filter = _filter.get();
+        if ( _opts.bench ) { return bench_filter( _opts ); }
+    }
+    if ( _opts.bench ) { return benchmark( _opts ); }
+    if ( _opts.archive ) { return write_archive( _opts ); }
+    return write_text( _opts );
+}
@@ -0,0 +1,98 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Generator.h"
+#include "Deck.h"
+#include "Bitboard.h"
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr std::uint32_t M0{0xD2511F53u};
+    constexpr std::uint32_t M1{0xCD9E8D57u};
+    constexpr std::uint32_t W0{0x9E3779B9u};
+    constexpr std::uint32_t W1{0xBB67AE85u};
+
+    inline
+    void mulhilo( std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo )
+    {
+        std::uint64_t const _p{std::uint64_t(a) * b};
+        hi = static_cast<std::uint32_t>(_p >> 32);
+        lo = static_cast<std::uint32_t>(_p);
+    }
+
+    //!> a sorted deck: 13 of each seat
+    std::array<int, 52> make_sorted()
+    {
+        std::array<int, 52> _cards;
+        for ( int _slot{0}; _slot < 52; ++_slot ) { _cards[_slot] = 1 + _slot / 13; }
+        return _cards;
+    }
+
+    std::array<int, 52> const   sorted = make_sorted();
+}
+
+    Philox::Block /* static */
+    Philox::block( Block ctr, std::array<std::uint32_t, 2> key )
+    {
+        for ( int _round{0}; _round < 10; ++_round )
+        {
+            std::uint32_t   _hi0, _lo0, _hi1, _lo1;
+            mulhilo( M0, ctr[0], _hi0, _lo0 );
+            mulhilo( M1, ctr[2], _hi1, _lo1 );
+            ctr = {{ _hi1 ^ ctr[1] ^ key[0], _lo1, _hi0 ^ ctr[3] ^ key[1], _lo0 }};
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+
+    // Fisher-Yates over the seat array
+    Deck&
+    DealGenerator::deal( Deck& deck, std::uint64_t board ) const
+    {
+        Philox  _rng(seed_, board);
+        std::copy( sorted.begin(), sorted.end(), deck.begin() );
+        for ( std::uint32_t _last{51}; _last > 0; --_last )
+        {
+            std::swap( deck[_last], deck[_rng.below( _last + 1 )] );
+        }
+        return deck;
+    }
+
+    Bitboard&
+    DealGenerator::deal( Bitboard& bits, std::uint64_t board ) const
+    {
+        Philox                      _rng(seed_, board);
+        std::array<signed char, 52> _seats;
+        std::copy( sorted.begin(), sorted.end(), _seats.begin() );
+        for ( std::uint32_t _last{51}; _last > 0; --_last )
+        {
+            std::swap( _seats[_last], _seats[_rng.below( _last + 1 )] );
+        }
+        bits = Bitboard();
+        for ( int _slot{0}; _slot < 52; ++_slot ) { bits.hand( _seats[_slot] ) |= Bitboard::card( _slot ); }
+        return bits;
+    }
+
+    char*
+    DealGenerator::deal_hex( char* hex, std::size_t len, std::uint64_t board ) const
+    {
+        Deck    _deck;
+        return deal( _deck, board ).store_hex( hex, len );
+    }
+
+    // contiguous slices, one per thread
+    void
+    DealGenerator::deal( Deck* decks, std::uint64_t first, std::size_t count, unsigned threads ) const
+    {
+        Utility::Parallel::slices( count, threads, 1024, [=]( std::size_t begin, std::size_t end, unsigned )
+        {
+            for ( std::size_t _ndx{begin}; _ndx < end; ++_ndx ) { deal( decks[_ndx], first + _ndx ); }
+        });
+    }
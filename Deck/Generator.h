@@ -0,0 +1,97 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_GENERATOR_H
+#define BRIDGE_GENERATOR_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+class Deck;
+class Bitboard;
+
+    /**
+     * @class Philox
+     * @brief Counter based generator (Philox4x32-10, Salmon et al. 2011).
+     * Output is a pure function of (key, counter): streams keyed by
+     * (seed, board) are independent and can be replayed in any order.
+     */
+    class Philox
+    {
+    public:
+        using Block = std::array<std::uint32_t, 4>;
+
+        ~Philox() noexcept = default;
+        //!> key: 64-bit seed; stream: (board, sub-stream) in the counter
+        Philox(std::uint64_t seed, std::uint64_t board, std::uint32_t stream = 0)
+        : key_{{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}}
+        , ctr_{{0, stream, static_cast<std::uint32_t>(board), static_cast<std::uint32_t>(board >> 32)}}
+        {}
+
+        std::uint32_t operator()()
+        {
+            if ( ndx_ == 4 ) { refill_(); }
+            return out_[ndx_++];
+        }
+
+        //!> uniform in [0, range), unbiased (Lemire's multiply and reject)
+        std::uint32_t below( std::uint32_t range )
+        {
+            std::uint64_t   _m{std::uint64_t((*this)()) * range};
+            if ( static_cast<std::uint32_t>(_m) < range )
+            {
+                std::uint32_t const _floor{(0u - range) % range};
+                while ( static_cast<std::uint32_t>(_m) < _floor ) { _m = std::uint64_t((*this)()) * range; }
+            }
+            return static_cast<std::uint32_t>(_m >> 32);
+        }
+
+        static Block block( Block ctr, std::array<std::uint32_t, 2> key );
+
+    private:
+        std::array<std::uint32_t, 2>   key_;
+        Block                           ctr_;
+        Block                           out_;
+        int                             ndx_{4};
+
+        void refill_()
+        {
+            out_ = block( ctr_, key_ );
+            ++ctr_[0];
+            ndx_ = 0;
+        }
+    };
+
+    /**
+     * @class DealGenerator
+     * @brief Uniformly random deals, reproducible from (seed, board).
+     * Any board can be regenerated on its own, so a range of boards can
+     * be split across threads with identical results.
+     */
+    class DealGenerator
+    {
+    public:
+        ~DealGenerator() noexcept = default;
+        explicit
+        DealGenerator(std::uint64_t seed) : seed_(seed) {}
+
+        std::uint64_t seed() const { return seed_; }
+
+        Deck& deal( Deck&, std::uint64_t board ) const;
+        //!> same deal as the Deck version
+        Bitboard& deal( Bitboard&, std::uint64_t board ) const;
+        char* deal_hex( char* hex, std::size_t len, std::uint64_t board ) const;
+
+        //!> boards first .. first + count - 1 into decks[0 .. count - 1]
+        void deal( Deck* decks, std::uint64_t first, std::size_t count, unsigned threads = 0 ) const;
+
+    private:
+        std::uint64_t   seed_;
+    };
+
+#endif // BRIDGE_GENERATOR_H
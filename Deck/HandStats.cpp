@@ -0,0 +1,212 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "HandStats.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <functional>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HANDSTATS_AVX2 1
+#endif
+
+namespace
+{
+    // by the top four cards of a suit as a nibble, A = 8 .. J = 1
+    constexpr int top_points( int top ) { return 4 * (top >> 3 & 1) + 3 * (top >> 2 & 1) + 2 * (top >> 1 & 1) + (top & 1); }
+    constexpr int top_controls( int top ) { return 2 * (top >> 3 & 1) + (top >> 2 & 1); }
+    constexpr int top_bits( int top ) { return (top >> 3 & 1) + (top >> 2 & 1) + (top >> 1 & 1) + (top & 1); }
+
+    //!> the honours that count against losers, by min(length, 3)
+    int const   keep[4] = {0, 8, 12, 14};
+
+    inline
+    int top_losers( int length, int top )
+    {
+        int const   _cap{std::min( length, 3 )};
+        return _cap - top_bits( top & keep[_cap] );
+    }
+
+    //!> lengths of the four suits of a hand, one per 16-bit lane
+    inline
+    Bitboard::Mask lane_counts( Bitboard::Mask hand )
+    {
+        hand = hand - ((hand >> 1) & 0x5555555555555555ull);
+        hand = (hand & 0x3333333333333333ull) + ((hand >> 2) & 0x3333333333333333ull);
+        hand = (hand + (hand >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return (hand + (hand >> 8)) & 0x00FF00FF00FF00FFull;
+    }
+}
+
+    void
+    HandStats::resize( std::size_t size )
+    {
+        size_ = size;
+        for ( auto& _col : hcp ) { _col.resize( size ); }
+        for ( auto& _col : length ) { _col.resize( size ); }
+        for ( auto& _col : pattern ) { _col.resize( size ); }
+        for ( auto& _col : controls ) { _col.resize( size ); }
+        for ( auto& _col : losers ) { _col.resize( size ); }
+        for ( auto& _col : side_hcp ) { _col.resize( size ); }
+        for ( auto& _col : side_length ) { _col.resize( size ); }
+        for ( auto& _col : side_controls ) { _col.resize( size ); }
+        for ( auto& _col : side_losers ) { _col.resize( size ); }
+    }
+
+    bool /* static */
+    HandStats::simd()
+    {
+#ifdef HANDSTATS_AVX2
+        static bool const   _avx2{__builtin_cpu_supports( "avx2" ) != 0};
+        return _avx2;
+#else
+        return false;
+#endif
+    }
+
+    void
+    HandStats::evaluate( Bitboard const* deals, std::size_t count, unsigned threads )
+    {
+        run_( deals, count, threads, simd() );
+    }
+
+    void
+    HandStats::evaluate_swar( Bitboard const* deals, std::size_t count, unsigned threads )
+    {
+        run_( deals, count, threads, false );
+    }
+
+    // contiguous slices, one per thread, as in DealGenerator
+    void
+    HandStats::run_( Bitboard const* deals, std::size_t count, unsigned threads, bool simd )
+    {
+        resize( count );
+        auto const  _kernel(simd ? &HandStats::avx2_ : &HandStats::swar_);
+        Utility::Parallel::slices( count, threads, 4096, [=]( std::size_t begin, std::size_t end, unsigned )
+        {
+            (this->*_kernel)( deals, begin, end );
+        });
+    }
+
+    /**
+     * One row from the lengths [4 * (seat - 1) + suit] and the per seat
+     * sums of points, controls and losers (sums[4 * feature + seat - 1]).
+     */
+    void
+    HandStats::store_( std::size_t row, std::uint16_t const* lengths, std::uint8_t const* sums )
+    {
+        for ( int _ndx{0}; _ndx < 4; ++_ndx )
+        {
+            std::uint16_t const*    _len{lengths + 4 * _ndx};
+            int                     _sorted[4] = {_len[0], _len[1], _len[2], _len[3]};
+            std::sort( _sorted, _sorted + 4, std::greater<int>() );
+            pattern[_ndx][row]  = static_cast<std::uint16_t>(1000 * _sorted[0] + 100 * _sorted[1] + 10 * _sorted[2] + _sorted[3]);
+            hcp[_ndx][row]      = sums[_ndx];
+            controls[_ndx][row] = sums[4 + _ndx];
+            losers[_ndx][row]   = sums[8 + _ndx];
+            for ( int _suit{0}; _suit < 4; ++_suit ) { length[4 * _ndx + _suit][row] = static_cast<std::uint8_t>(_len[_suit]); }
+        }
+        // NS are seats 2 and 4, EW 1 and 3
+        for ( int _side{0}; _side < 2; ++_side )
+        {
+            int const   _one{_side == 0 ? 1 : 0};
+            int const   _two{_one + 2};
+            side_hcp[_side][row]      = static_cast<std::uint8_t>(sums[_one] + sums[_two]);
+            side_controls[_side][row] = static_cast<std::uint8_t>(sums[4 + _one] + sums[4 + _two]);
+            side_losers[_side][row]   = static_cast<std::uint8_t>(sums[8 + _one] + sums[8 + _two]);
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                side_length[4 * _side + _suit][row] = static_cast<std::uint8_t>(lengths[4 * _one + _suit] + lengths[4 * _two + _suit]);
+            }
+        }
+    }
+
+    void
+    HandStats::swar_( Bitboard const* deals, std::size_t begin, std::size_t end )
+    {
+        for ( std::size_t _row{begin}; _row < end; ++_row )
+        {
+            std::uint16_t   _lengths[16];
+            std::uint8_t    _sums[12] = {};
+            for ( int _ndx{0}; _ndx < 4; ++_ndx )
+            {
+                Bitboard::Mask const    _hand{deals[_row].hand( _ndx + 1 )};
+                Bitboard::Mask const    _counts{lane_counts( _hand )};
+                for ( int _suit{0}; _suit < 4; ++_suit )
+                {
+                    int const   _len{static_cast<int>(_counts >> (16 * _suit) & 0xFF)};
+                    int const   _top{static_cast<int>(_hand >> (16 * _suit + 9) & 15)};
+                    _lengths[4 * _ndx + _suit] = static_cast<std::uint16_t>(_len);
+                    _sums[_ndx]     += top_points( _top );
+                    _sums[4 + _ndx] += top_controls( _top );
+                    _sums[8 + _ndx] += top_losers( _len, _top );
+                }
+            }
+            store_( _row, _lengths, _sums );
+        }
+    }
+
+#ifdef HANDSTATS_AVX2
+    /**
+     * A deal is one register: a 64-bit hand per seat, a 16-bit lane per
+     * suit. Byte popcounts come from a nibble shuffle and are paired into
+     * the lanes; the top four cards of each lane index the point, control
+     * and honour tables; sad_epu8 sums the lanes of each hand.
+     */
+    __attribute__((target("avx2")))
+    void
+    HandStats::avx2_( Bitboard const* deals, std::size_t begin, std::size_t end )
+    {
+#define NIBBLES(F) F(0), F(1), F(2), F(3), F(4), F(5), F(6), F(7), F(8), F(9), F(10), F(11), F(12), F(13), F(14), F(15)
+#define TABLE(F) _mm256_setr_epi8( NIBBLES(F), NIBBLES(F) )
+#define KEEP(n) static_cast<char>(n < 4 ? keep[n & 3] : 0)
+        __m256i const   _low{_mm256_set1_epi8( 0x0F )};
+        __m256i const   _top4{_mm256_set1_epi16( 0x000F )};
+        __m256i const   _three{_mm256_set1_epi16( 3 )};
+        __m256i const   _ones{_mm256_set1_epi8( 1 )};
+        __m256i const   _zero{_mm256_setzero_si256()};
+        __m256i const   _bits{TABLE(top_bits)};
+        __m256i const   _points{TABLE(top_points)};
+        __m256i const   _controls{TABLE(top_controls)};
+        __m256i const   _keep{TABLE(KEEP)};
+#undef KEEP
+#undef TABLE
+#undef NIBBLES
+
+        for ( std::size_t _row{begin}; _row < end; ++_row )
+        {
+            Bitboard const& _deal(deals[_row]);
+            __m256i const   _hands{_mm256_setr_epi64x( static_cast<long long>(_deal.hand( 1 )), static_cast<long long>(_deal.hand( 2 )),
+                                                       static_cast<long long>(_deal.hand( 3 )), static_cast<long long>(_deal.hand( 4 )) )};
+            __m256i const   _bytes{_mm256_add_epi8( _mm256_shuffle_epi8( _bits, _mm256_and_si256( _hands, _low ) ),
+                                                    _mm256_shuffle_epi8( _bits, _mm256_and_si256( _mm256_srli_epi16( _hands, 4 ), _low ) ) )};
+            __m256i const   _lengths{_mm256_maddubs_epi16( _bytes, _ones )};
+            __m256i const   _top{_mm256_and_si256( _mm256_srli_epi16( _hands, 9 ), _top4 )};
+            __m256i const   _cap{_mm256_min_epi16( _lengths, _three )};
+            __m256i const   _honours{_mm256_shuffle_epi8( _bits, _mm256_and_si256( _top, _mm256_shuffle_epi8( _keep, _cap ) ) )};
+            __m256i const   _losers{_mm256_sub_epi16( _cap, _honours )};
+
+            alignas(32) std::uint16_t   _lanes[16];
+            alignas(32) std::uint64_t   _sums[3][4];
+            _mm256_store_si256( reinterpret_cast<__m256i*>(_lanes), _lengths );
+            _mm256_store_si256( reinterpret_cast<__m256i*>(_sums[0]), _mm256_sad_epu8( _mm256_shuffle_epi8( _points, _top ), _zero ) );
+            _mm256_store_si256( reinterpret_cast<__m256i*>(_sums[1]), _mm256_sad_epu8( _mm256_shuffle_epi8( _controls, _top ), _zero ) );
+            _mm256_store_si256( reinterpret_cast<__m256i*>(_sums[2]), _mm256_sad_epu8( _losers, _zero ) );
+
+            std::uint8_t    _bytesums[12];
+            for ( int _ndx{0}; _ndx < 12; ++_ndx ) { _bytesums[_ndx] = static_cast<std::uint8_t>(_sums[_ndx / 4][_ndx % 4]); }
+            store_( _row, _lanes, _bytesums );
+        }
+    }
+#else
+    void
+    HandStats::avx2_( Bitboard const* deals, std::size_t begin, std::size_t end )
+    {
+        swar_( deals, begin, end );
+    }
+#endif
@@ -0,0 +1,76 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_HANDSTATS_H
+#define BRIDGE_HANDSTATS_H
+
+#include "Bitboard.h"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+    /**
+     * @class HandStats
+     * @brief Hand features for many deals, one column per feature.
+     * Columns are indexed by deal; seats are WNES 1..4 at [seat - 1],
+     * suits SHDC, sides NS (0) and EW (1). For each seat:
+     *   hcp        4-3-2-1 points
+     *   length     suit lengths, at [4 * (seat - 1) + suit]
+     *   pattern    lengths longest first as a number, e.g. 5431
+     *   controls   ace 2, king 1
+     *   losers     losing trick count: per suit the missing A K Q among
+     *              the top min(length, 3) cards
+     * and the same summed for each side (side_length at [4 * side + suit]).
+     *
+     * All four hands of a deal are evaluated together: with AVX2 the deal
+     * is one 256-bit register, lengths come from a nibble popcount shuffle
+     * and the points, controls and losers of each suit from shuffles of
+     * its top four cards. Without it the same is done by SWAR on each
+     * 64-bit hand. The AVX2 kernel is chosen at run time.
+     */
+    class HandStats
+    {
+    public:
+        template<typename T, std::size_t N>
+        using Columns = std::array<std::vector<T>, N>;
+
+        Columns<std::uint8_t, 4>    hcp;
+        Columns<std::uint8_t, 16>   length;
+        Columns<std::uint16_t, 4>   pattern;
+        Columns<std::uint8_t, 4>    controls;
+        Columns<std::uint8_t, 4>    losers;
+        Columns<std::uint8_t, 2>    side_hcp;
+        Columns<std::uint8_t, 8>    side_length;
+        Columns<std::uint8_t, 2>    side_controls;
+        Columns<std::uint8_t, 2>    side_losers;
+
+        ~HandStats() noexcept = default;
+        HandStats() = default;
+
+        std::size_t size() const { return size_; }
+        void resize( std::size_t );
+
+        //!> deals[0 .. count - 1] into rows 0 .. count - 1, resizing to fit
+        void evaluate( Bitboard const* deals, std::size_t count, unsigned threads = 0 );
+        //!> same, always with the portable kernel
+        void evaluate_swar( Bitboard const* deals, std::size_t count, unsigned threads = 0 );
+
+        //!> whether evaluate() uses the AVX2 kernel on this machine
+        static bool simd();
+
+    private:
+        std::size_t     size_{0};
+
+        void run_( Bitboard const* deals, std::size_t count, unsigned threads, bool simd );
+        void avx2_( Bitboard const* deals, std::size_t begin, std::size_t end );
+        void swar_( Bitboard const* deals, std::size_t begin, std::size_t end );
+        void store_( std::size_t row, std::uint16_t const* lengths, std::uint8_t const* sums );
+    };
+
+#endif // BRIDGE_HANDSTATS_H
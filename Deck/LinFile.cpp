@@ -0,0 +1,322 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "LinFile.h"
+#include "ChunkPool.h"
+#include "Deck.h"
+#include "Parallel.h"
+#include "PlayState.h"
+#include "StrFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <errno.h>
+
+namespace
+{
+    struct Chunk
+    {
+        char const*                 begin;
+        char const*                 end;
+        std::size_t                 line{0};   //!< lines before this chunk
+        std::size_t                 lines{0};
+        std::vector<LinFile::Record> records;
+
+        Chunk(char const* b, char const* e) : begin(b), end(e) {}
+    };
+
+    inline
+    bool is_tag( char const* ptr, char a, char b )
+    {
+        return (ptr[0] | 0x20) == a && (ptr[1] | 0x20) == b;
+    }
+
+    //!> A..2 to 0..12, -1 if not a rank
+    int to_rank( char c )
+    {
+        switch ( c )
+        {
+        case 'A': case 'a': return 0;
+        case 'K': case 'k': return 1;
+        case 'Q': case 'q': return 2;
+        case 'J': case 'j': return 3;
+        case 'T': case 't': return 4;
+        default: return c >= '2' && c <= '9' ? 14 - (c - '0') : -1;
+        }
+    }
+
+    //!> S H D C to 0..3, -1 if not a suit
+    int to_suit( char c )
+    {
+        switch ( c )
+        {
+        case 'S': case 's': return 0;
+        case 'H': case 'h': return 1;
+        case 'D': case 'd': return 2;
+        case 'C': case 'c': return 3;
+        default: return -1;
+        }
+    }
+
+    //!> denomination in bidding order (C D H S N), -1 if none
+    int to_denom( char c )
+    {
+        switch ( c )
+        {
+        case 'C': case 'c': return 0;
+        case 'D': case 'd': return 1;
+        case 'H': case 'h': return 2;
+        case 'S': case 's': return 3;
+        case 'N': case 'n': return 4;
+        default: return -1;
+        }
+    }
+
+    bool fail( LinFile::Record& rec, char const* line, char const* at, char const* what )
+    {
+        if ( !rec.error )
+        {
+            rec.error  = what;
+            rec.column = static_cast<std::size_t>(at - line) + 1;
+        }
+        return false;
+    }
+
+    //!> a call value: p, d, r (or x, xx), 1C..7N with NT, an alert '!' is dropped
+    int to_call( char const* ptr, char const* end )
+    {
+        while ( end > ptr && (end[-1] == '!' || end[-1] == ' ') ) { --end; }
+        std::size_t const   _len(end - ptr);
+        if ( _len == 1 )
+        {
+            switch ( *ptr | 0x20 )
+            {
+            case 'p': return LinFile::PASS;
+            case 'd': case 'x': return LinFile::DOUBLE;
+            case 'r': return LinFile::REDOUBLE;
+            default: return -1;
+            }
+        }
+        if ( _len == 2 && (ptr[0] | 0x20) == 'x' && (ptr[1] | 0x20) == 'x' ) { return LinFile::REDOUBLE; }
+        if ( _len < 2 || *ptr < '1' || *ptr > '7' ) { return -1; }
+        int const   _denom{to_denom( ptr[1] )};
+        if ( _denom < 0 || (_len > 2 && !(_denom == 4 && _len == 3 && (ptr[2] | 0x20) == 't')) ) { return -1; }
+        return LinFile::BID + 5 * (*ptr - '1') + _denom;
+    }
+
+    /**
+     * Contract and declarer from the calls; false if a call is out of turn
+     * or insufficient. The auction need not be finished.
+     */
+    bool settle( LinFile::Record& rec )
+    {
+        int     _last{-1};      //!< last bid
+        int     _bidder{0};
+        int     _dbl{0};
+        int     _passes{0};
+        for ( std::size_t _ndx{0}; _ndx < rec.calls; ++_ndx )
+        {
+            int const   _call{rec.auction[_ndx]};
+            int const   _seat{static_cast<int>((rec.dlr - 1 + _ndx) % 4) + 1};
+            bool const  _theirs{_last >= 0 && _seat % 2 != _bidder % 2};
+            if ( _passes >= 3 && (_last >= 0 || _passes >= 4) ) { return false; }
+            switch ( _call )
+            {
+            case LinFile::PASS:     ++_passes; continue;
+            case LinFile::DOUBLE:   if ( !_theirs || _dbl != 0 ) { return false; } _dbl = 1; break;
+            case LinFile::REDOUBLE: if ( _last < 0 || _theirs || _dbl != 1 ) { return false; } _dbl = 2; break;
+            default:
+                if ( _call <= _last ) { return false; }
+                _last   = _call;
+                _bidder = _seat;
+                _dbl    = 0;
+                break;
+            }
+            _passes = 0;
+        }
+        if ( _last < 0 ) { rec.level = 0; rec.by = 0; return true; }
+
+        int const   _denom{(_last - LinFile::BID) % 5};
+        rec.level  = static_cast<std::int8_t>((_last - LinFile::BID) / 5 + 1);
+        rec.strain = static_cast<std::int8_t>(_denom == 4 ? LinFile::NOTRUMP : 3 - _denom);
+        rec.dbl    = static_cast<std::int8_t>(_dbl);
+        // first of the side to name the denomination
+        for ( std::size_t _ndx{0}; _ndx < rec.calls; ++_ndx )
+        {
+            int const   _call{rec.auction[_ndx]};
+            int const   _seat{static_cast<int>((rec.dlr - 1 + _ndx) % 4) + 1};
+            if ( _call >= LinFile::BID && (_call - LinFile::BID) % 5 == _denom && _seat % 2 == _bidder % 2 )
+            {
+                rec.by = static_cast<std::int8_t>(_seat);
+                break;
+            }
+        }
+        return true;
+    }
+}
+
+    bool /* static */
+    LinFile::parse( Record& rec, char const* line, char const* eol, bool replay )
+    {
+        rec = Record();
+        if ( eol > line && eol[-1] == '\r' ) { --eol; }
+
+        std::array<char const*, 52> _at;    //!< where each card is, for errors
+        std::size_t _players{0};
+        bool        _dealt{false};
+        for ( char const* _ptr{line}; _ptr < eol; )
+        {
+            char const* _bar{static_cast<char const*>(std::memchr( _ptr, '|', eol - _ptr ))};
+            if ( !_bar ) { break; }
+            char const* _value{_bar + 1};
+            char const* _end{static_cast<char const*>(std::memchr( _value, '|', eol - _value ))};
+            if ( !_end ) { _end = eol; }
+            char const* _tag{_bar - _ptr == 2 ? _ptr : nullptr};
+            _ptr = _end < eol ? _end + 1 : eol;
+            if ( !_tag ) { fail( rec, line, _bar, "expected a tag" ); continue; }
+
+            if ( is_tag( _tag, 'p', 'n' ) )
+            {
+                for ( char const* _name{_value}; _players < 4 && _name <= _end; ++_players )
+                {
+                    char const* _comma{static_cast<char const*>(std::memchr( _name, ',', _end - _name ))};
+                    if ( !_comma ) { _comma = _end; }
+                    rec.players[_players] = {_name, static_cast<std::size_t>(_comma - _name)};
+                    _name = _comma + 1;
+                }
+            }
+            else if ( is_tag( _tag, 'm', 'd' ) )
+            {
+                // load_lin_s reads to the end of the line, so the value goes through a stack buffer
+                char    _buf[96];
+                Deck    _deck;
+                if ( _end - _value < 2 || _end - _value >= static_cast<std::ptrdiff_t>(sizeof _buf)
+                  || *_value < '1' || *_value > '4' )
+                {
+                    fail( rec, line, _value, "bad deal" );
+                    continue;
+                }
+                std::copy( _value, _end, _buf );
+                _buf[_end - _value] = '\0';
+                rec.dlr = static_cast<std::int8_t>((*_value - '1' + 3) % 4 + 1);
+                _dealt  = _deck.load_lin_s( _buf ) && Bitboard(_deck).complete();
+                if ( !_dealt ) { fail( rec, line, _value, "bad deal" ); continue; }
+                rec.deal = Bitboard(_deck);
+            }
+            else if ( is_tag( _tag, 's', 'v' ) )
+            {
+                switch ( _end > _value ? *_value | 0x20 : 'o' )
+                {
+                case 'o': case '0': case '-': rec.vul = 1; break;
+                case 'n': rec.vul = 2; break;
+                case 'e': rec.vul = 3; break;
+                case 'b': rec.vul = 4; break;
+                default: fail( rec, line, _value, "bad vulnerability" ); break;
+                }
+            }
+            else if ( is_tag( _tag, 'a', 'h' ) ) { rec.board = {_value, static_cast<std::size_t>(_end - _value)}; }
+            else if ( is_tag( _tag, 'm', 'b' ) )
+            {
+                int const   _call{to_call( _value, _end )};
+                if ( _call < 0 ) { fail( rec, line, _value, "bad call" ); continue; }
+                if ( rec.calls == MAXCALLS ) { fail( rec, line, _value, "auction too long" ); continue; }
+                rec.auction[rec.calls++] = static_cast<std::uint8_t>(_call);
+            }
+            else if ( is_tag( _tag, 'p', 'c' ) )
+            {
+                int const   _suit{_end - _value == 2 ? to_suit( _value[0] ) : -1};
+                int const   _rank{_end - _value == 2 ? to_rank( _value[1] ) : -1};
+                if ( _suit < 0 || _rank < 0 ) { fail( rec, line, _value, "bad card" ); continue; }
+                if ( rec.cards == 52 ) { fail( rec, line, _value, "too many cards" ); continue; }
+                _at[rec.cards] = _value;
+                rec.play[rec.cards++] = static_cast<std::uint8_t>(13 * _suit + _rank);
+            }
+            else if ( is_tag( _tag, 'm', 'c' ) )
+            {
+                int _claim{0};
+                for ( char const* _digit{_value}; _digit < _end && _claim <= 13; ++_digit )
+                {
+                    _claim = *_digit >= '0' && *_digit <= '9' ? 10 * _claim + *_digit - '0' : 99;
+                }
+                if ( _end == _value || _claim > 13 ) { fail( rec, line, _value, "bad claim" ); continue; }
+                rec.claim = static_cast<std::int8_t>(_claim);
+            }
+        }
+        if ( !_dealt ) { return fail( rec, line, line, "no deal" ); }
+
+        if ( !settle( rec ) ) { return fail( rec, line, line, "bad auction" ); }
+        if ( rec.level && rec.claim >= 0 ) { rec.tricks = rec.claim; }
+        if ( !replay || !rec.level || !rec.cards ) { return rec.ok(); }
+
+        // the cards, checked by a PlayState; leads start from declarer's left
+        Deck        _deck;
+        PlayState   _state(rec.deal.to_deck( _deck ), rec.by, rec.strain);
+        for ( std::size_t _ndx{0}; _ndx < rec.cards; ++_ndx )
+        {
+            if ( !_state.play( rec.play[_ndx] ) ) { return fail( rec, line, _at[_ndx], "card not playable" ); }
+        }
+        if ( rec.claim < 0 && _state.played() == 52 ) { rec.tricks = static_cast<std::int8_t>(_state.tricks( rec.by )); }
+        return rec.ok();
+    }
+
+    LinFile::Stats /* static */
+    LinFile::read( char const* buf, std::size_t len, Sink const& sink, Options const& opts )
+    {
+        Stats       _stats;
+        _stats.bytes = len;
+        std::size_t _size{std::max<std::size_t>( opts.chunk, 4096 )};
+
+        std::vector<Chunk>  _chunks(ChunkPool::split<Chunk>( buf, len, _size ));
+        unsigned const      _threads{Utility::Parallel::threads( opts.threads, _chunks.size() )};
+
+        //!> decode in the pool; line numbers are fixed up in order
+        ChunkPool::run( _chunks.size(), _threads, [&]( std::size_t ndx )
+        {
+            Chunk&  _chunk(_chunks[ndx]);
+            for ( char const* _ptr{_chunk.begin}; _ptr < _chunk.end; )
+            {
+                char const* _eol = static_cast<char const*>(std::memchr( _ptr, '\n', _chunk.end - _ptr ));
+                if ( !_eol ) { _eol = _chunk.end; }
+                ++_chunk.lines;
+                if ( _eol > _ptr && !(_eol - _ptr == 1 && *_ptr == '\r') ) // blank lines are skipped
+                {
+                    _chunk.records.emplace_back();
+                    parse( _chunk.records.back(), _ptr, _eol, opts.replay );
+                    _chunk.records.back().line = _chunk.lines;
+                }
+                _ptr = _eol + 1;
+            }
+        },
+        [&]( std::size_t ndx )
+        {
+            Chunk&  _chunk(_chunks[ndx]);
+            for ( auto& _rec : _chunk.records )
+            {
+                _rec.line += _stats.lines;
+                if ( _rec.ok() ) { continue; }
+                if ( _stats.errors++ == 0 ) { _stats.first_error = _rec.line; }
+            }
+            _stats.lines   += _chunk.lines;
+            _stats.records += _chunk.records.size();
+            if ( !_chunk.records.empty() ) { sink( _chunk.records.data(), _chunk.records.size() ); }
+            std::vector<Record>().swap( _chunk.records );
+        });
+        return _stats;
+    }
+
+    LinFile::Stats /* static */
+    LinFile::read( char const* file, Sink const& sink, Options const& opts )
+    {
+        Utility::StrFile    _file(file);
+        if ( !_file )
+        {
+            Stats   _stats;
+            _stats.io_error = _file.error() ? _file.error() : EINVAL;
+            return _stats;
+        }
+        return read( _file.get(), _file.size(), sink, opts );
+    }
@@ -0,0 +1,98 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_LINFILE_H
+#define BRIDGE_LINFILE_H
+
+#include "Bitboard.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+    /**
+     * @class LinFile
+     * @brief BBO LIN records, one per line, decoded on a pool of threads.
+     * Of the tags, pn| (players), md| (dealer and deal), sv| (vulnerability),
+     * ah| (board), mb| (calls), pc| (cards) and mc| (claim) are read; the
+     * rest are skipped. A Record is fixed size: the deal as a Bitboard, the
+     * calls and cards as bytes, and names as spans of the input.
+     *
+     * The contract and declarer come from the auction. With Options::replay
+     * the cards are played through a PlayState, which checks that each is
+     * legal and counts declarer's tricks; a claim (mc|) overrides the count.
+     *
+     * Input is split into chunks at line boundaries, as in Converter, and
+     * records reach the Sink a chunk at a time in input order; they (and
+     * the spans in them) are valid only during the call.
+     */
+    class LinFile
+    {
+    public:
+        enum { NOTRUMP = 4, MAXCALLS = 64 };
+        //!> calls are PASS, DOUBLE, REDOUBLE or BID + 5 * (level - 1) + denomination (C D H S N)
+        enum Call : std::uint8_t { PASS = 0, DOUBLE = 1, REDOUBLE = 2, BID = 3 };
+
+        struct Text
+        {
+            char const* ptr{nullptr};
+            std::size_t len{0};
+        };
+
+        struct Record
+        {
+            std::size_t             line{0};
+            std::array<Text, 4>     players;        //!< as in pn|, S W N E
+            Text                    board;
+            Bitboard                deal;
+            std::int8_t             dlr{0};         //!< seat WNES 1..4
+            std::int8_t             vul{1};         //!< 1..4 none, NS, EW, both
+            std::int8_t             level{0};       //!< 0 if passed out
+            std::int8_t             strain{NOTRUMP};//!< S H D C N 0..4
+            std::int8_t             dbl{0};
+            std::int8_t             by{0};          //!< declarer seat
+            std::int8_t             tricks{-1};     //!< declarer's, -1 if not known
+            std::int8_t             claim{-1};
+            std::uint8_t            calls{0};
+            std::uint8_t            cards{0};
+            std::array<std::uint8_t, MAXCALLS>  auction{};
+            std::array<std::uint8_t, 52>        play{}; //!< Deck slots
+            char const*             error{nullptr}; //!< what went wrong, if anything
+            std::size_t             column{0};      //!< where (from 1)
+
+            bool ok() const { return error == nullptr; }
+        };
+
+        struct Options
+        {
+            unsigned        threads{0};     //!< 0: hardware concurrency
+            std::size_t     chunk{1 << 22}; //!< bytes per chunk (approximate)
+            bool            replay{true};
+        };
+
+        struct Stats
+        {
+            std::size_t     bytes{0};
+            std::size_t     lines{0};
+            std::size_t     records{0};
+            std::size_t     errors{0};
+            std::size_t     first_error{0}; //!< line number, 1-based
+            int             io_error{0};    //!< errno, if the file did not open
+        };
+
+        using Sink = std::function<void( Record const* records, std::size_t count )>;
+
+        //!> one record, no terminator; false (with error set) if not valid
+        static bool parse( Record&, char const* line, char const* eol, bool replay = true );
+
+        static Stats read( char const* buf, std::size_t len, Sink const&, Options const& );
+        //!> the file is mapped with Utility::StrFile
+        static Stats read( char const* file, Sink const&, Options const& );
+    };
+
+#endif // BRIDGE_LINFILE_H
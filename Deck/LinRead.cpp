@@ -0,0 +1,117 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "LinFile.h"
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+    /**
+     * LinRead: BBO LIN records, one per line, one output line each: the
+     * board, hex deal, dealer, vulnerability, number of calls, contract
+     * with declarer and tricks, and number of cards played.
+     *   LinRead [-j threads] [-n] [-b] [file]
+     * -n skips replaying the cards. Errors go to STDERR as file:line:column.
+     * -b only decodes, and reports records and megabytes per second. With
+     * no file, STDIN is read into memory.
+     */
+
+namespace
+{
+    char const  seats[]  = "-WNES";
+    char const  strains[][3] = { "S", "H", "D", "C", "NT" };
+    char const* vuls[]   = { "?", "None", "NS", "EW", "All" };
+    char const* dbls[]   = { "", "X", "XX" };
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-j threads] [-n] [-b] [file]\n";
+    return 2;
+}
+
+void show( std::ostream& os, LinFile::Record const& rec )
+{
+    char    _hex[32]{"-"};
+    if ( rec.ok() ) { rec.deal.store_hex( _hex ); }
+    if ( rec.board.len ) { os.write( rec.board.ptr, static_cast<std::streamsize>(rec.board.len) ); }
+    else { os << "-"; }
+    os << " " << _hex << " " << seats[rec.dlr] << " " << vuls[rec.vul] << " " << int(rec.calls) << " ";
+    if ( !rec.level ) { os << "Pass"; }
+    else
+    {
+        os << int(rec.level) << strains[rec.strain] << dbls[rec.dbl] << seats[rec.by];
+        if ( rec.tricks < 0 ) { os << "?"; }
+        else { os << " " << int(rec.tricks); }
+    }
+    os << " " << int(rec.cards) << (rec.claim >= 0 ? " claim" : "") << "\n";
+}
+
+int main( int ac, char* av[] )
+{
+    LinFile::Options    _opts;
+    bool                _bench{false};
+    int                 _opt;
+
+    while ( (_opt = ::getopt( ac, av, "j:nb" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'j': _opts.threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'n': _opts.replay  = false; break;
+        case 'b': _bench        = true; break;
+        default: return usage( av[0] );
+        }
+    }
+
+    char const*     _name{::optind < ac ? av[::optind] : "-"};
+    auto            _sink([&]( LinFile::Record const* records, std::size_t count )
+    {
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            LinFile::Record const&  _rec(records[_ndx]);
+            if ( !_rec.ok() ) { std::cerr << _name << ":" << _rec.line << ":" << _rec.column << ": " << _rec.error << "\n"; }
+            if ( !_bench ) { show( std::cout, _rec ); }
+        }
+    });
+
+    using Clock = std::chrono::steady_clock;
+    std::string         _input;
+    LinFile::Stats      _stats;
+    auto                _t0(Clock::now());
+    if ( ::optind < ac )
+    {
+        _stats = LinFile::read( _name, _sink, _opts );
+        if ( _stats.io_error )
+        {
+            std::cerr << "Cannot open " << _name << ": " << ::strerror( _stats.io_error ) << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        _input.assign( std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>() );
+        _t0 = Clock::now();
+        _stats = LinFile::read( _input.data(), _input.size(), _sink, _opts );
+    }
+    double const    _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    if ( _bench )
+    {
+        std::cout << "records: " << _stats.records << " errors: " << _stats.errors
+                  << " records/sec: " << (_stats.records / _secs)
+                  << " MB/sec: " << (_stats.bytes / _secs / 1e6) << "\n";
+    }
+    if ( _stats.errors ) { std::cerr << _stats.errors << " errors (first at line " << _stats.first_error << ")\n"; }
+    std::cout << std::flush;
+    return _stats.errors ? 1 : 0;
+}
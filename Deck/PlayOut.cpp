@@ -0,0 +1,161 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "PlayState.h"
+#include "Deck.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * PlayOut: the tricks of a played hand.
+     *   PlayOut [-d W|N|E|S] [-s S|H|D|C|N] [-b] [file]
+     * Each line is a hex deal, optionally followed by a play string (see
+     * PlayState.h). Prints each trick, its winner and the tricks won by
+     * declarer's side. -b plays every deal out at random and back with
+     * undo, checks the deal is restored and reports plays per second. With
+     * no file, STDIN is read.
+     */
+
+namespace
+{
+    char const  seats[] = " WNES";
+    char const  suits[] = "SHDCN";
+    char const  ranks[] = "AKQJT98765432";
+
+    int index_of( char const* names, char name )
+    {
+        char const* _at{std::strchr( names, ::toupper( name ) )};
+        return name && _at ? static_cast<int>(_at - names) : -1;
+    }
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-d W|N|E|S] [-s S|H|D|C|N] [-b] [file]\n";
+    return 2;
+}
+
+void show( PlayState const& state )
+{
+    for ( int _trick{0}; _trick <= 12 && 4 * _trick < state.played(); ++_trick )
+    {
+        std::cout << std::string(_trick < 9 ? " " : "") << (_trick + 1) << "  " << seats[state[_trick][0]] << ":";
+        for ( int _pos{0}; _pos < 4 && 4 * _trick + _pos < state.played(); ++_pos )
+        {
+            int const   _slot{state[_trick][1 + _pos]};
+            std::cout << " " << suits[_slot / 13] << ranks[_slot % 13];
+        }
+        std::cout << "  " << seats[state.winner( _trick )] << "\n";
+    }
+    std::cout << "declarer: " << state.tricks( state.declarer() )
+              << " defenders: " << state.tricks( state.declarer() % 4 + 1 ) << "\n";
+}
+
+int benchmark( std::vector<Deck> const& deals, int declarer, int strain )
+{
+    using Clock = std::chrono::steady_clock;
+    std::mt19937    _rng(20250101);
+    PlayState       _state;
+    int             _moves[13];
+    std::size_t     _plays{0};
+    std::size_t     _bad{0};
+
+    auto const  _t0(Clock::now());
+    for ( int _round{0}; _round < 20; ++_round )
+    {
+        for ( auto const& _deal : deals )
+        {
+            _state.reset( _deal, declarer, strain );
+            while ( _state.next() )
+            {
+                int const   _count{_state.legal_moves( _moves )};
+                _state.play( _moves[_rng() % _count] );
+            }
+            _plays += 52;
+            while ( _state.undo() ) {}
+            Bitboard const  _start(_deal);
+            _bad += Bitboard(_state.layout()) != _start || _state.cards() != _start
+                 || _state.tricks( 1 ) != 0 || _state.tricks( 2 ) != 0;
+        }
+    }
+    double const    _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    std::cout << "deals: " << deals.size() << " plays: " << _plays
+              << " plays/sec (with undo): " << (_plays / _secs)
+              << (_bad ? "  (NOT RESTORED)" : "") << std::endl;
+    return _bad ? 1 : 0;
+}
+
+int main( int ac, char* av[] )
+{
+    int     _declarer{4};
+    int     _strain{PlayState::NOTRUMP};
+    bool    _bench{false};
+    int     _opt;
+
+    while ( (_opt = ::getopt( ac, av, "d:s:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'd': _declarer = index_of( seats + 1, ::optarg[0] ) + 1; break;
+        case 's': _strain   = index_of( suits, ::optarg[0] ); break;
+        case 'b': _bench    = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( _declarer < 1 || _strain < 0 ) { return usage( av[0] ); }
+
+    std::ifstream   _file;
+    if ( ::optind < ac )
+    {
+        _file.open( av[::optind] );
+        if ( !_file )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+    }
+    else { std::cerr << "Reading from STDIN\n"; }
+    std::istream&   _in(::optind < ac ? static_cast<std::istream&>(_file) : std::cin);
+
+    std::vector<Deck>   _deals;
+    std::size_t         _bad{0};
+    std::string         _line;
+    PlayState           _state;
+    while ( std::getline( _in, _line ) )
+    {
+        char            _hex[32]{};
+        char            _plays[64]{};
+        if ( std::sscanf( _line.c_str(), "%31s %63s", _hex, _plays ) < 1 ) { continue; }
+        Deck    _deck;
+        if ( !_deck.load_hex( _hex ) ) { ++_bad; continue; }
+        if ( _bench ) { _deals.push_back( _deck ); continue; }
+
+        _state.reset( _deck, _declarer, _strain );
+        if ( *_plays && !_state.load_plays( _plays ) )
+        {
+            std::cerr << "Bad play: " << _line << "\n";
+            ++_bad;
+            continue;
+        }
+        std::cout << _hex << "\n";
+        show( _state );
+    }
+    if ( _bad ) { std::cerr << _bad << " bad lines\n"; }
+    if ( _bench ) { return benchmark( _deals, _declarer, _strain ); }
+    std::cout << std::flush;
+    return _bad ? 1 : 0;
+}
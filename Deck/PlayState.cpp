@@ -0,0 +1,183 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "PlayState.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    char const  letters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+    inline
+    Bitboard::Mask lane( int suit ) { return Bitboard::SUIT << (16 * suit); }
+}
+
+    PlayState::PlayState(Deck const& deck, int declarer, int strain)
+    {
+        reset( deck, declarer, strain );
+    }
+
+    PlayState&
+    PlayState::reset( Deck const& deck, int declarer, int strain )
+    {
+        layout_   = deck;
+        cards_    = Bitboard(deck);
+        tricks_   = {};
+        best_     = {};
+        won_      = {{0, 0}};
+        played_   = 0;
+        declarer_ = declarer;
+        strain_   = strain;
+        tricks_[0][0] = declarer % 4 + 1;
+        return *this;
+    }
+
+    // a lower slot is a higher card of the same suit
+    bool
+    PlayState::beats_( int slot, int other ) const
+    {
+        return slot / 13 == other / 13 ? slot < other : slot / 13 == strain_;
+    }
+
+    Bitboard::Mask
+    PlayState::legal_mask() const
+    {
+        if ( played_ >= 52 ) { return 0; }
+        Bitboard::Mask const    _hand{cards_.hand( seat_( played_ ) )};
+        if ( played_ % 4 == 0 ) { return _hand; }
+        Bitboard::Mask const    _suit{_hand & lane( tricks_[played_ / 4][1] / 13 )};
+        return _suit ? _suit : _hand;
+    }
+
+    bool
+    PlayState::legal( int slot ) const
+    {
+        return slot >= 0 && slot < 52 && (legal_mask() & Bitboard::card( slot )) != 0;
+    }
+
+    int
+    PlayState::legal_moves( int* slots ) const
+    {
+        int     _count{0};
+        // slots ascend with the suits S..C and, within a suit, from the top bit
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            for ( unsigned _cards(static_cast<unsigned>(legal_mask() >> (16 * _suit)) & Bitboard::SUIT); _cards; )
+            {
+                int const   _top{31 - __builtin_clz( _cards )};
+                slots[_count++] = 13 * _suit + 12 - _top;
+                _cards &= ~(1u << _top);
+            }
+        }
+        return _count;
+    }
+
+    bool
+    PlayState::play( int slot )
+    {
+        if ( !legal( slot ) ) { return false; }
+        int const   _trick{played_ / 4};
+        int const   _pos{played_ % 4};
+        int const   _seat{seat_( played_ )};
+
+        layout_[slot] = 0;
+        cards_.hand( _seat ) &= ~Bitboard::card( slot );
+        tricks_[_trick][1 + _pos] = slot;
+        best_[played_] = _pos == 0 || beats_( slot, tricks_[_trick][1 + best_[played_ - 1]] ) ? _pos : best_[played_ - 1];
+        if ( ++played_ % 4 == 0 )
+        {
+            int const   _winner{(tricks_[_trick][0] - 1 + best_[played_ - 1]) % 4 + 1};
+            ++won_[_winner % 2];
+            tricks_[_trick + 1][0] = _winner;
+        }
+        return true;
+    }
+
+    bool
+    PlayState::undo()
+    {
+        if ( played_ == 0 ) { return false; }
+        if ( played_ % 4 == 0 ) { --won_[tricks_[played_ / 4][0] % 2]; }
+        --played_;
+        int const   _slot{tricks_[played_ / 4][1 + played_ % 4]};
+        int const   _seat{seat_( played_ )};
+        layout_[_slot] = _seat;
+        cards_.hand( _seat ) |= Bitboard::card( _slot );
+        tricks_[played_ / 4][1 + played_ % 4] = 0;
+        return true;
+    }
+
+    int
+    PlayState::winner( int trick ) const
+    {
+        if ( trick < 0 || trick > 12 || 4 * trick >= played_ ) { return 0; }
+        int const   _last{std::min( played_, 4 * trick + 4 ) - 1};
+        return (tricks_[trick][0] - 1 + best_[_last]) % 4 + 1;
+    }
+
+    char*
+    PlayState::store_plays( char* buf, std::size_t len ) const
+    {
+        if ( len < static_cast<std::size_t>(played_) + 2 ) { return buf; }
+        *buf++ = static_cast<char>('0' + tricks_[0][0]);
+        for ( int _play{0}; _play < played_; ++_play ) { *buf++ = letters[tricks_[_play / 4][1 + _play % 4]]; }
+        *buf = '\0';
+        return buf;
+    }
+
+    bool
+    PlayState::load_plays( char const* plays )
+    {
+        while ( undo() ) {}
+        if ( *plays != '0' + tricks_[0][0] ) { return false; }
+        while ( *++plays )
+        {
+            char const* _letter{std::strchr( letters, *plays )};
+            if ( !_letter || !play( static_cast<int>(_letter - letters) ) )
+            {
+                while ( undo() ) {}
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void
+    PlayState::to_js( nlohmann::json& j ) const
+    {
+        j["declarer"] = declarer_;
+        j["strain"]   = strain_;
+        nlohmann::json& _tricks(j["tricks"] = nlohmann::json::array());
+        for ( int _trick{0}; 4 * _trick < played_; ++_trick )
+        {
+            nlohmann::json  _row{tricks_[_trick][0]};
+            for ( int _pos{0}; _pos < 4 && 4 * _trick + _pos < played_; ++_pos ) { _row.push_back( tricks_[_trick][1 + _pos] ); }
+            _tricks.push_back( _row );
+        }
+    }
+
+    // replays the tricks on the initial layout; a row is the leader and at
+    // most 4 cards, and only the last may be short
+    bool
+    PlayState::fr_js( nlohmann::json const& j )
+    {
+        while ( undo() ) {}
+        if ( j.value( "declarer", declarer_ ) != declarer_ || j.value( "strain", strain_ ) != strain_ ) { return false; }
+        auto const  _tricks(j.find( "tricks" ));
+        if ( _tricks == j.end() || !_tricks->is_array() || _tricks->size() > 13 ) { return false; }
+        for ( auto const& _row : *_tricks )
+        {
+            if ( !_row.is_array() || _row.empty() || _row.size() > 5 || played_ % 4 != 0
+              || _row[0] != tricks_[played_ / 4][0] ) { while ( undo() ) {} return false; }
+            for ( std::size_t _ndx{1}; _ndx < _row.size(); ++_ndx )
+            {
+                if ( !_row[_ndx].is_number_integer() || !play( _row[_ndx].get<int>() ) ) { while ( undo() ) {} return false; }
+            }
+        }
+        return true;
+    }
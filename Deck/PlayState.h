@@ -0,0 +1,94 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_PLAYSTATE_H
+#define BRIDGE_PLAYSTATE_H
+
+#include "Deck.h"
+#include "Bitboard.h"
+
+#include "nlohmann/json.hpp"
+#include <array>
+#include <cstddef>
+
+    /**
+     * @class PlayState
+     * @brief The play of a deal, as in README.txt section 1: the layout
+     * with played cards set to 0 and the 13 x 5 trick array (leader, then
+     * the slots played in order).
+     * A Bitboard of the cards left runs alongside the layout, so play(),
+     * undo(), the follow suit test and the legal moves are O(1) (the
+     * moves are at most 13 bits to walk). The winning card of the trick in
+     * progress is kept after every play, so undo() needs no rescan.
+     *
+     * Strains are SHDC 0..3 and NOTRUMP; seats are WNES 1..4. The play
+     * string is the opening leader's seat digit and one letter per card,
+     * A..Z a..z for slots 0..51, e.g. "2Ahb" (up to 53 characters).
+     */
+    class PlayState
+    {
+    public:
+        enum { NOTRUMP = 4 };
+        using Trick = std::array<int, 5>; //!< leader, slots in order of play
+
+        ~PlayState() noexcept = default;
+        PlayState() = default;
+        //!> the opening lead is from declarer's left
+        PlayState(Deck const&, int declarer, int strain);
+
+        PlayState& reset( Deck const&, int declarer, int strain );
+
+        //!> false (and no change) if the card may not be played now
+        bool play( int slot );
+        bool undo();
+
+        //!> seat to play, 0 when the hand is over
+        int  next() const { return played_ < 52 ? seat_( played_ ) : 0; }
+        bool legal( int slot ) const;
+        Bitboard::Mask legal_mask() const;
+        //!> legal slots, ascending; returns how many
+        int  legal_moves( int* slots ) const;
+
+        int played() const { return played_; }
+        int trick() const { return played_ / 4; }       //!< trick in progress (13 when done)
+        int remaining() const { return 13 - played_ / 4; }
+        //!> seat winning the trick so far (or that won it), 0 if not started
+        int winner( int trick ) const;
+        int tricks( int seat ) const { return won_[seat % 2]; } //!< by the side of 'seat'
+        int declarer() const { return declarer_; }
+        int strain() const { return strain_; }
+
+        Deck const&     layout() const { return layout_; }
+        Bitboard const& cards() const { return cards_; }
+        Trick const&    operator[]( std::size_t trick ) const { return tricks_[trick]; }
+
+        //!> the play string; load_plays() replays it on the initial layout
+        char* store_plays( char* buf, std::size_t len ) const;
+        bool  load_plays( char const* plays );
+
+        //!> {"declarer", "strain", "tricks": [[leader, slot...], ...]} for the tricks started
+        void to_js( nlohmann::json& ) const;
+        bool fr_js( nlohmann::json const& );
+
+    private:
+        Deck                    layout_;
+        Bitboard                cards_;
+        std::array<Trick, 14>   tricks_{};  //!< one spare for the leader after the last
+        std::array<int, 52>     best_{};    //!< position (0..3) of the winning card after each play
+        std::array<int, 2>      won_{{0, 0}}; //!< NS, EW as seat % 2
+        int                     played_{0};
+        int                     declarer_{0};
+        int                     strain_{NOTRUMP};
+
+        int  seat_( int play ) const
+        {
+            return (tricks_[play / 4][0] - 1 + play % 4) % 4 + 1;
+        }
+        bool beats_( int slot, int other ) const;
+    };
+
+#endif // BRIDGE_PLAYSTATE_H
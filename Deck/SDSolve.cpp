@@ -0,0 +1,226 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Constraint.h"
+#include "Deck.h"
+#include "Simulator.h"
+#include "Solver.h"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * SDSolve: single dummy tricks for hex deals, one per line.
+     *   SDSolve [-d W|N|E|S] [-s S|H|D|C|N] [-v seats] [-n samples] [-r seed]
+     *           [-c spec] [-m millis] [-j threads] [-b] [file]
+     * The seats in -v (default declarer and dummy) are seen; the other two
+     * hands are dealt at random, -n times, meeting the -c spec if given (see
+     * Constraint.h), and declarer's double dummy tricks are counted on each.
+     * Each line is the deal, the tricks on the actual layout, the mean and
+     * spread over the samples and the count for each number of tricks:
+     *   <deal>  9  8.62 0.71  7:9 8:26 9:62 10:3
+     * -m stops sampling after that many milliseconds. -b deals and scores
+     * points instead, on 1 thread and on -j, checks they agree and reports
+     * samples/sec, then checks the tricks of a few samples against a fresh
+     * solver. With no file, STDIN is read.
+     */
+
+namespace
+{
+    char const  seats[] = "WNES";
+    char const  strains[] = "SHDCN";
+
+    struct Options
+    {
+        int                 declarer{4};
+        int                 strain{4};
+        unsigned            visible{0};
+        std::string         spec;
+        bool                bench{false};
+        SingleDummy::Options    sim;
+    };
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-d W|N|E|S] [-s S|H|D|C|N] [-v seats] [-n samples] [-r seed]"
+                 " [-c spec] [-m millis] [-j threads] [-b] [file]\n";
+    return 2;
+}
+
+//!> deals from the input, with the line numbers of the bad ones
+std::vector<Deck> read_deals( std::istream& in, std::vector<std::size_t>& bad )
+{
+    std::vector<Deck>   _decks;
+    std::string         _line;
+    for ( std::size_t _lineno{1}; std::getline( in, _line ); ++_lineno )
+    {
+        while ( !_line.empty() && ::isspace( _line.back() ) ) { _line.pop_back(); }
+        if ( _line.empty() ) { continue; }
+        _decks.emplace_back();
+        if ( !_decks.back().load_hex( _line.c_str() ) )
+        {
+            _decks.pop_back();
+            bad.push_back( _lineno );
+        }
+    }
+    return _decks;
+}
+
+//!> the tricks Evaluator, whose solver is kept from sample to sample, against
+//!> a fresh DDSolver on each layout (DDSolve -b checks the solver itself)
+std::size_t tricks_check( Options const& opts, std::vector<Deck> const& decks )
+{
+    SingleDummy::Options    _few(opts.sim);
+    _few.samples = 4;
+    _few.millis  = 0;
+    std::size_t _scored{0}, _wrong{0};
+    for ( std::size_t _ndx{0}; _ndx < decks.size() && _ndx < 2; ++_ndx )
+    {
+        SingleDummy::Layout const   _layout(decks[_ndx], ~opts.visible & 15u);
+        SingleDummy::Result const   _result(SingleDummy::run( _layout, SingleDummy::tricks( opts.declarer, opts.strain ), _few ));
+        for ( std::size_t _sample{0}; _sample < _result.values.size(); ++_sample )
+        {
+            Bitboard    _deal;
+            if ( !_result.scored[_sample]
+              || !SingleDummy::sample( _layout, _few.seed, _sample, _deal, _few.filter, _few.tries ) ) { continue; }
+            ++_scored;
+            _wrong += _result.values[_sample] != DDSolver().tricks( _deal, opts.declarer, opts.strain );
+        }
+    }
+    std::cout << "tricks: " << _scored << " samples, differing: " << _wrong << std::endl;
+    return _wrong;
+}
+
+//!> points of the first hidden seat: cheap, so the time is in dealing and the pool
+int benchmark( Options const& opts, std::vector<Deck> const& decks )
+{
+    int _seat{1};
+    while ( opts.visible & 1u << (_seat - 1) ) { ++_seat; }
+    SingleDummy::Factory const  _points([_seat]()
+    {
+        return SingleDummy::Evaluator([_seat]( Bitboard const& deal ) { return deal.hcp( _seat ); });
+    });
+
+    SingleDummy::Options    _one(opts.sim);
+    _one.threads = 1;
+    double          _secs[2]{0, 0};
+    std::size_t     _samples{0}, _steals{0}, _differ{0};
+    for ( Deck const& _deck : decks )
+    {
+        SingleDummy::Layout const   _layout(_deck, ~opts.visible & 15u);
+        SingleDummy::Result const   _serial(SingleDummy::run( _layout, _points, _one ));
+        SingleDummy::Result const   _pooled(SingleDummy::run( _layout, _points, opts.sim ));
+        _secs[0] += _serial.secs;
+        _secs[1] += _pooled.secs;
+        _samples += _serial.completed;
+        _steals  += _pooled.steals;
+        _differ  += _serial.values != _pooled.values || _serial.scored != _pooled.scored;
+    }
+    std::cout << "deals: " << decks.size() << " samples: " << _samples << "\n"
+              << "1 thread: " << (_samples / _secs[0]) << " samples/sec\n"
+              << "pool: " << (_samples / _secs[1]) << " samples/sec, steals: " << _steals
+              << ", deals differing: " << _differ << std::endl;
+    std::size_t const   _wrong{tricks_check( opts, decks )};
+    return _differ || _wrong ? 1 : 0;
+}
+
+int main( int ac, char* av[] )
+{
+    Options     _opts;
+    char const* _view{nullptr};
+    int         _opt;
+
+    _opts.sim.samples = 100;
+    while ( (_opt = ::getopt( ac, av, "d:s:v:n:r:c:m:j:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'd':
+            if ( !*::optarg || !::strchr( seats, ::toupper( *::optarg ) ) ) { return usage( av[0] ); }
+            _opts.declarer = static_cast<int>(::strchr( seats, ::toupper( *::optarg ) ) - seats) + 1;
+            break;
+        case 's':
+            if ( !*::optarg || !::strchr( strains, ::toupper( *::optarg ) ) ) { return usage( av[0] ); }
+            _opts.strain = static_cast<int>(::strchr( strains, ::toupper( *::optarg ) ) - strains);
+            break;
+        case 'v': _view = ::optarg; break;
+        case 'n': _opts.sim.samples = std::strtoull( ::optarg, nullptr, 10 ); break;
+        case 'r': _opts.sim.seed    = std::strtoull( ::optarg, nullptr, 0 ); break;
+        case 'c': _opts.spec        = ::optarg; break;
+        case 'm': _opts.sim.millis  = std::atol( ::optarg ); break;
+        case 'j': _opts.sim.threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'b': _opts.bench       = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( _view )
+    {
+        for ( char const* _ptr{_view}; *_ptr; ++_ptr )
+        {
+            if ( !::strchr( seats, ::toupper( *_ptr ) ) ) { return usage( av[0] ); }
+            _opts.visible |= 1u << (::strchr( seats, ::toupper( *_ptr ) ) - seats);
+        }
+    }
+    else { _opts.visible = 1u << (_opts.declarer - 1) | 1u << ((_opts.declarer + 1) % 4); }
+
+    std::unique_ptr<DealFilter> _filter;
+    if ( !_opts.spec.empty() )
+    {
+        _filter.reset( new DealFilter(_opts.spec.c_str()) );
+        if ( !*_filter )
+        {
+            std::cerr << "Bad spec: " << _filter->error() << "\n";
+            return 2;
+        }
+        _opts.sim.filter = _filter.get();
+    }
+
+    std::vector<std::size_t>    _bad;
+    std::vector<Deck>           _decks;
+    if ( ::optind < ac )
+    {
+        std::ifstream   _in(av[::optind]);
+        if ( !_in )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        _decks = read_deals( _in, _bad );
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        _decks = read_deals( std::cin, _bad );
+    }
+    if ( !_bad.empty() ) { std::cerr << _bad.size() << " bad deals (first at line " << _bad.front() << ")\n"; }
+    if ( _opts.bench ) { return benchmark( _opts, _decks ); }
+
+    SingleDummy::Factory const  _tricks(SingleDummy::tricks( _opts.declarer, _opts.strain ));
+    SingleDummy::Evaluator      _actual(_tricks());
+    char                        _hex[64];
+    for ( Deck const& _deck : _decks )
+    {
+        SingleDummy::Layout const   _layout(_deck, ~_opts.visible & 15u);
+        SingleDummy::Summary const  _sum(SingleDummy::run( _layout, _tricks, _opts.sim ).summary());
+        char                        _stats[32];
+        std::snprintf( _stats, sizeof _stats, "%5.2f %4.2f", _sum.mean, _sum.stdev );
+        _deck.store_hex( _hex, sizeof _hex );
+        std::cout << _hex << "  " << _actual( Bitboard(_deck) ) << "  " << _stats << " ";
+        for ( auto const& _freq : _sum.freq ) { std::cout << " " << _freq.first << ":" << _freq.second; }
+        std::cout << "\n";
+    }
+    std::cout << std::flush;
+    return _bad.empty() ? 0 : 1;
+}
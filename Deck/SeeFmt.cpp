@@ -31,7 +31,7 @@ void show_deck( std::ostream& os, Deck const& deck )
     _cards["cards"] = deck;
     os << _cards.dump() << std::endl;
     //
-    Deal(deck.begin()).visualize( os );
+    PackedDeal(deck.begin()).visualize( os );
     //
     Buffer32        _hex{&Deck::store_hex, deck};
     os << _hex.get() << std::endl;
@@ -0,0 +1,247 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Simulator.h"
+#include "Constraint.h"
+#include "Deck.h"
+#include "Generator.h"
+#include "Parallel.h"
+#include "Solver.h"
+#include "SpinLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    //!> a worker's samples [lo, hi); the owner takes from the front, thieves from the back
+    struct Range
+    {
+        std::atomic_flag    flag = ATOMIC_FLAG_INIT;
+        std::size_t         lo{0};
+        std::size_t         hi{0};
+    };
+}
+
+    SingleDummy::Layout::Layout(Deck const& deck, unsigned hidden)
+    : Layout(Bitboard(deck), hidden)
+    {}
+
+    SingleDummy::Layout::Layout(Bitboard const& deal, unsigned hidden)
+    {
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            if ( hidden & 1u << (_seat - 1) )
+            {
+                unknown |= deal.hand( _seat );
+                counts[_seat - 1] = deal.count( _seat );
+            }
+            else { known.hand( _seat ) = deal.hand( _seat ); }
+        }
+    }
+
+    bool
+    SingleDummy::Layout::fix( int slot, int seat )
+    {
+        Bitboard::Mask const    _card{Bitboard::card( slot )};
+        if ( seat < 1 || seat > 4 || !(unknown & _card) || counts[seat - 1] == 0 ) { return false; }
+        unknown &= ~_card;
+        --counts[seat - 1];
+        known.hand( seat ) |= _card;
+        return true;
+    }
+
+    bool
+    SingleDummy::Layout::valid() const
+    {
+        Bitboard::Mask  _seen{unknown};
+        int             _count{0};
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            if ( _seen & known.hand( _seat ) || counts[_seat - 1] < 0 ) { return false; }
+            _seen  |= known.hand( _seat );
+            _count += counts[_seat - 1];
+        }
+        return _count == Bitboard::popcount( unknown );
+    }
+
+    // partial Fisher-Yates over the unknown cards, seat by seat; the last seat takes the rest
+    bool /* static */
+    SingleDummy::sample( Layout const& layout, std::uint64_t seed, std::uint64_t n, Bitboard& out,
+                         DealFilter const* filter, unsigned tries, std::size_t* rejected )
+    {
+        if ( !layout.valid() ) { return false; } // the counts would overrun the unknown cards
+        std::array<int, 52> _bits;
+        std::uint32_t       _size{0};
+        for ( Bitboard::Mask _mask{layout.unknown}; _mask; _mask &= _mask - 1 )
+        {
+            _bits[_size++] = __builtin_ctzll( _mask );
+        }
+
+        for ( unsigned _try{0}; _try < std::max( tries, 1u ); ++_try )
+        {
+            Philox                  _rng(seed, n, _try);
+            std::array<int, 52>     _cards(_bits);
+            std::uint32_t           _next{0};
+            out = layout.known;
+            for ( int _seat{1}; _seat <= 4; ++_seat )
+            {
+                std::uint32_t const _stop{_seat == 4 ? _size : _next + layout.counts[_seat - 1]};
+                for ( ; _next < _stop; ++_next )
+                {
+                    if ( _seat < 4 ) { std::swap( _cards[_next], _cards[_next + _rng.below( _size - _next )] ); }
+                    out.hand( _seat ) |= Bitboard::Mask(1) << _cards[_next];
+                }
+            }
+            if ( !filter || (*filter)( out ) ) { return true; }
+            if ( rejected ) { ++*rejected; }
+        }
+        return false;
+    }
+
+    SingleDummy::Result /* static */
+    SingleDummy::run( Layout const& layout, Factory const& factory, Options const& opts )
+    {
+        using Clock = std::chrono::steady_clock;
+        auto const          _t0(Clock::now());
+        auto const          _deadline(_t0 + std::chrono::milliseconds(opts.millis));
+        std::size_t const   _count{opts.samples};
+        std::size_t const   _batch{std::max<std::size_t>( opts.batch, 1 )};
+        unsigned const      _threads{Utility::Parallel::threads( opts.threads, _count / _batch )};
+
+        Result  _result;
+        _result.values.assign( _count, 0 );
+        _result.scored.assign( _count, 0 );
+        if ( !layout.valid() ) { return _result; }
+
+        std::unique_ptr<Range[]>        _ranges(new Range[_threads]);
+        std::vector<std::size_t>        _done(_threads, 0);
+        std::vector<std::size_t>        _rejected(_threads, 0);
+        std::vector<std::size_t>        _steals(_threads, 0);
+        for ( unsigned _ndx{0}; _ndx < _threads; ++_ndx )
+        {
+            _ranges[_ndx].lo = _count * _ndx / _threads;
+            _ranges[_ndx].hi = _count * (_ndx + 1) / _threads;
+        }
+
+        //!> the back half of the fullest range, into 'mine'; false if all are empty
+        auto    _steal([&]( unsigned self ) -> bool
+        {
+            for ( ;; )
+            {
+                unsigned    _victim{self};
+                std::size_t _most{0};
+                for ( unsigned _ndx{0}; _ndx < _threads; ++_ndx )
+                {
+                    Utility::SpinLock   _lock(_ranges[_ndx].flag);
+                    if ( _ranges[_ndx].hi - _ranges[_ndx].lo > _most )
+                    {
+                        _most   = _ranges[_ndx].hi - _ranges[_ndx].lo;
+                        _victim = _ndx;
+                    }
+                }
+                if ( _most == 0 ) { return false; }
+
+                std::size_t _lo, _hi;
+                {
+                    Utility::SpinLock   _lock(_ranges[_victim].flag);
+                    Range&              _range(_ranges[_victim]);
+                    if ( _range.hi == _range.lo ) { continue; } // taken meanwhile
+                    _hi = _range.hi;
+                    _lo = _range.lo + (_range.hi - _range.lo) / 2;
+                    _range.hi = _lo;
+                }
+                Utility::SpinLock   _lock(_ranges[self].flag);
+                _ranges[self].lo = _lo;
+                _ranges[self].hi = _hi;
+                ++_steals[self];
+                return true;
+            }
+        });
+
+        std::vector<std::thread>    _pool;
+        for ( unsigned _self{0}; _self < _threads; ++_self )
+        {
+            _pool.emplace_back( [&, _self]()
+            {
+                Evaluator   _eval(factory());
+                Bitboard    _deal;
+                Range&      _mine(_ranges[_self]);
+                for ( ;; )
+                {
+                    if ( opts.millis > 0 && Clock::now() >= _deadline ) { return; }
+                    std::size_t _lo, _hi;
+                    {
+                        Utility::SpinLock   _lock(_mine.flag);
+                        _lo = _mine.lo;
+                        _hi = std::min( _mine.hi, _lo + _batch );
+                        _mine.lo = _hi;
+                    }
+                    if ( _lo == _hi )
+                    {
+                        if ( !_steal( _self ) ) { return; }
+                        continue;
+                    }
+                    for ( std::size_t _ndx{_lo}; _ndx < _hi; ++_ndx )
+                    {
+                        if ( !sample( layout, opts.seed, _ndx, _deal, opts.filter, opts.tries, &_rejected[_self] ) ) { continue; }
+                        _result.values[_ndx] = _eval( _deal );
+                        _result.scored[_ndx] = 1;
+                        ++_done[_self];
+                    }
+                }
+            });
+        }
+        for ( auto& _thread : _pool ) { _thread.join(); }
+
+        for ( unsigned _ndx{0}; _ndx < _threads; ++_ndx )
+        {
+            _result.completed += _done[_ndx];
+            _result.rejected  += _rejected[_ndx];
+            _result.steals    += _steals[_ndx];
+        }
+        _result.secs = std::chrono::duration<double>(Clock::now() - _t0).count();
+        return _result;
+    }
+
+    SingleDummy::Summary
+    SingleDummy::Result::summary() const
+    {
+        Summary _sum;
+        double  _total{0};
+        double  _squares{0};
+        for ( std::size_t _ndx{0}; _ndx < values.size(); ++_ndx )
+        {
+            if ( !scored[_ndx] ) { continue; }
+            ++_sum.count;
+            ++_sum.freq[values[_ndx]];
+            _total   += values[_ndx];
+            _squares += double(values[_ndx]) * values[_ndx];
+        }
+        if ( _sum.count )
+        {
+            _sum.mean  = _total / _sum.count;
+            _sum.stdev = std::sqrt( std::max( 0.0, _squares / _sum.count - _sum.mean * _sum.mean ) );
+        }
+        return _sum;
+    }
+
+    SingleDummy::Factory /* static */
+    SingleDummy::tricks( int declarer, int strain )
+    {
+        return [declarer, strain]()
+        {
+            std::shared_ptr<DDSolver>   _solver(std::make_shared<DDSolver>());
+            return Evaluator([_solver, declarer, strain]( Bitboard const& deal )
+            {
+                return _solver->tricks( deal, declarer, strain );
+            });
+        };
+    }
@@ -0,0 +1,105 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_SIMULATOR_H
+#define BRIDGE_SIMULATOR_H
+
+#include "Bitboard.h"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+class Deck;
+class DealFilter;
+
+    /**
+     * @class SingleDummy
+     * @brief Random layouts consistent with what one seat knows, each scored
+     * by an Evaluator, e.g. double dummy tricks.
+     * A Layout has the cards fixed to seats, the unknown cards and how many
+     * of them each seat holds; cards in neither are out of play. Sample n
+     * of seed s deals the unknown cards with Philox(s, n), so it is the same
+     * layout whichever thread draws it, and an optional DealFilter (e.g.
+     * inferences from the auction) is met by redrawing on further streams.
+     *
+     * run() spreads the samples over a pool: each worker starts with an
+     * equal range and takes batches from its front; when it runs dry it
+     * steals the back half of the fullest range left. The values land by
+     * sample number, so the result does not depend on the thread count.
+     * With a time limit, samples not started by then are left out.
+     */
+    class SingleDummy
+    {
+    public:
+        struct Layout
+        {
+            Bitboard            known;
+            Bitboard::Mask      unknown{0};
+            std::array<int, 4>  counts{{0, 0, 0, 0}};   //!< unknown cards per seat, W N E S
+
+            Layout() = default;
+            //!> the cards of seats in 'hidden' (bit seat - 1) become unknown
+            Layout(Deck const&, unsigned hidden);
+            Layout(Bitboard const&, unsigned hidden);
+
+            //!> an unknown card known to be with 'seat'; false if it cannot be
+            bool fix( int slot, int seat );
+            bool valid() const;
+        };
+
+        using Evaluator = std::function<int( Bitboard const& )>;
+        //!> makes one Evaluator per worker, so each may keep its own state
+        using Factory   = std::function<Evaluator()>;
+
+        struct Options
+        {
+            std::uint64_t       seed{1};
+            std::size_t         samples{1000};
+            unsigned            threads{0};     //!< 0: hardware concurrency
+            std::size_t         batch{8};       //!< samples taken at a time
+            long                millis{0};      //!< time limit, 0 for none
+            unsigned            tries{1000};    //!< redraws allowed per sample
+            DealFilter const*   filter{nullptr};
+        };
+
+        struct Summary
+        {
+            std::size_t             count{0};
+            double                  mean{0};
+            double                  stdev{0};
+            std::map<int, std::size_t>  freq;   //!< value -> samples
+        };
+
+        struct Result
+        {
+            std::vector<int>            values;     //!< by sample number
+            std::vector<std::uint8_t>   scored;     //!< 0 if skipped (time) or never accepted
+            std::size_t                 completed{0};
+            std::size_t                 rejected{0};//!< filter redraws in all
+            std::size_t                 steals{0};
+            double                      secs{0};
+
+            Summary summary() const;
+        };
+
+        //!> layout 'n' of 'seed' into 'out'; false if the layout is not valid()
+        //!> or 'tries' draws all fail the filter
+        static bool sample( Layout const&, std::uint64_t seed, std::uint64_t n, Bitboard& out,
+                            DealFilter const* = nullptr, unsigned tries = 1000, std::size_t* rejected = nullptr );
+
+        //!> nothing is scored for a layout that is not valid()
+        static Result run( Layout const&, Factory const&, Options const& );
+
+        //!> double dummy tricks for declarer, a DDSolver per worker
+        static Factory tricks( int declarer, int strain );
+    };
+
+#endif // BRIDGE_SIMULATOR_H
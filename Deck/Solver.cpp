@@ -0,0 +1,551 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Solver.h"
+#include "Deck.h"
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace
+{
+    using Mask = Bitboard::Mask;
+
+    inline Mask lane( int suit ) { return Bitboard::SUIT << (16 * suit); }
+    inline int  low_bit( Mask mask ) { return __builtin_ctzll( mask ); }
+
+    //!> closes up a holding over the cards gone, and spreads bits two apart
+    struct Packed
+    {
+        std::uint8_t    close[128][128];    //!< [present][bits] low 7 ranks
+        std::uint16_t   apart[128];
+
+        Packed()
+        {
+            for ( unsigned _present{0}; _present < 128; ++_present )
+            {
+                for ( unsigned _bits{0}; _bits < 128; ++_bits )
+                {
+                    unsigned    _out{0};
+                    int         _to{0};
+                    for ( int _bit{0}; _bit < 7; ++_bit )
+                    {
+                        if ( _present >> _bit & 1 ) { _out |= (_bits >> _bit & 1u) << _to++; }
+                    }
+                    close[_present][_bits] = static_cast<std::uint8_t>(_out);
+                }
+                unsigned    _spread{0};
+                for ( int _bit{0}; _bit < 7; ++_bit ) { _spread |= (_present >> _bit & 1u) << (2 * _bit); }
+                apart[_present] = static_cast<std::uint16_t>(_spread);
+            }
+        }
+        unsigned squeeze( unsigned bits, unsigned present ) const
+        {
+            return close[present & 127][bits & 127] | unsigned(close[present >> 7][bits >> 7]) << __builtin_popcount( present & 127 );
+        }
+        std::uint32_t spread( unsigned bits ) const { return apart[bits & 127] | std::uint32_t(apart[bits >> 7]) << 14; }
+    } const packed;
+
+    struct Move
+    {
+        int     score;
+        Mask    card;
+    };
+}
+
+    DDSolver::DDSolver(unsigned bits)
+    : table_(std::size_t(1) << (std::min( std::max( bits, 10u ), 28u ) - 1))
+    , pool_(std::size_t(2) * table_.size())
+    , mask_(table_.size() - 1)
+    {}
+
+    bool
+    DDSolver::load_( Bitboard const& deal )
+    {
+        for ( int _seat{1}; _seat <= 4; ++_seat ) { hands_[_seat - 1] = deal.hand( _seat ); }
+        int const   _count{Bitboard::popcount( hands_[0] )};
+        return _count > 0
+            && Bitboard::popcount( hands_[1] ) == _count
+            && Bitboard::popcount( hands_[2] ) == _count
+            && Bitboard::popcount( hands_[3] ) == _count
+            && Bitboard::popcount( hands_[0] | hands_[1] | hands_[2] | hands_[3] ) == 4 * _count;
+    }
+
+    // entries from an earlier strain or deal are stale
+    void
+    DDSolver::reset_( int strain )
+    {
+        trump_ = strain;
+        clear_();
+    }
+
+    void
+    DDSolver::clear_()
+    {
+        if ( ++age_ == 0 )
+        {
+            for ( auto& _node : table_ ) { _node.age = 0; }
+            age_ = 1;
+        }
+        used_ = 0;
+        filled_ = 0;
+    }
+
+    /**
+     * A position by its 16 hand-suit lengths and, per suit, the owners of
+     * its cards from the top down (2 bits each, high bits first).
+     */
+    DDSolver::Position
+    DDSolver::position_( int leader ) const
+    {
+        Position    _pos;
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3]};
+        Mask const  _odd{hands_[1] | hands_[3]};
+        Mask const  _high{hands_[2] | hands_[3]};
+
+        _pos.leader = leader;
+        for ( int _hand{0}; _hand < 4; ++_hand )
+        {
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                _pos.lengths |= std::uint64_t(Bitboard::popcount( hands_[_hand] & lane( _suit ) )) << (4 * (4 * _hand + _suit));
+            }
+        }
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            unsigned const  _cards{static_cast<unsigned>(_all >> (16 * _suit) & Bitboard::SUIT)};
+            if ( !_cards ) { continue; }
+            unsigned const  _ones{static_cast<unsigned>(_odd >> (16 * _suit) & Bitboard::SUIT)};
+            unsigned const  _twos{static_cast<unsigned>(_high >> (16 * _suit) & Bitboard::SUIT)};
+            int const       _count{__builtin_popcount( _cards )};
+            _pos.owners[_suit] = (packed.spread( packed.squeeze( _ones, _cards ) )
+                               | packed.spread( packed.squeeze( _twos, _cards ) ) << 1) << (32 - 2 * _count);
+        }
+        return _pos;
+    }
+
+    //!> open addressing by lengths and leader; a full table starts over
+    DDSolver::Node*
+    DDSolver::node_( Position const& pos, bool add )
+    {
+        std::uint64_t   _hash{(pos.lengths + std::uint64_t(pos.leader)) * 0x9E3779B97F4A7C15ull};
+        std::size_t     _ndx{(_hash ^ _hash >> 31) & mask_};
+        for ( ;; _ndx = (_ndx + 1) & mask_ )
+        {
+            Node&   _node(table_[_ndx]);
+            if ( _node.age != age_ )
+            {
+                if ( !add ) { return nullptr; }
+                if ( 4 * ++used_ > 3 * table_.size() )
+                {
+                    clear_();
+                    return node_( pos, add );
+                }
+                _node.lengths = pos.lengths;
+                _node.leader = static_cast<std::uint8_t>(pos.leader);
+                _node.age = age_;
+                _node.head = 0;
+                return &_node;
+            }
+            if ( _node.lengths == pos.lengths && _node.leader == pos.leader ) { return &_node; }
+        }
+    }
+
+    //!> the cards that mattered, as the number from the top in each suit
+    DDSolver::Mask
+    DDSolver::top_( std::array<std::uint8_t, 4> const& depth ) const
+    {
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3]};
+        Mask        _top{0};
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            Mask    _cards{_all & lane( _suit )};
+            for ( int _ndx{0}; _ndx < depth[_suit]; ++_ndx )
+            {
+                Mask const  _card{Mask(1) << (63 - __builtin_clzll( _cards ))};
+                _top |= _card;
+                _cards &= ~_card;
+            }
+        }
+        return _top;
+    }
+
+    /**
+     * Tricks the leader's side can cash from the top: in each suit, the
+     * run of top cards in the leader's hand, then at most one run in
+     * partner's hand reached with a low card. Outside the trump suit, only
+     * as many as both opponents can follow to if either holds a trump.
+     * 'win' gets the cards counted, from the top of each run only as many
+     * as make 'enough' tricks: any position with those cards can cash them.
+     */
+    int
+    DDSolver::quick_( int leader, int enough, Mask& win ) const
+    {
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3]};
+        Mask const  _hand{hands_[leader]};
+        Mask const  _partner{hands_[leader ^ 2]};
+        Mask const  _lho{hands_[(leader + 1) & 3]};
+        Mask const  _rho{hands_[(leader + 3) & 3]};
+        bool const  _ruffs{trump_ != NOTRUMP && ((_lho | _rho) & lane( trump_ ))};
+        int         _quick{0};
+        int         _cross{0};
+        Mask        _entry{0};
+        Mask        _runs{0};
+
+        win = 0;
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            int     _limit{13};
+            if ( _ruffs && _suit != trump_ )
+            {
+                _limit = std::min( Bitboard::popcount( _lho & lane( _suit ) ), Bitboard::popcount( _rho & lane( _suit ) ) );
+            }
+            Mask const  _cards{_all & lane( _suit )};
+            if ( !_cards ) { continue; }
+            Mask const  _owner{(_hand & _cards) && (_hand >> (63 - __builtin_clzll( _cards )) & 1) ? _hand : _partner};
+            Mask        _run{0};
+            for ( Mask _rest{_cards}; _rest && Bitboard::popcount( _run ) < _limit; )
+            {
+                Mask const  _card{Mask(1) << (63 - __builtin_clzll( _rest ))};
+                if ( !(_owner & _card) ) { break; }
+                _run |= _card;
+                _rest &= ~_card;
+            }
+            if ( _owner == _hand ) { _runs |= _run; _quick += Bitboard::popcount( _run ); }
+            else if ( (_hand & _cards) && Bitboard::popcount( _run ) > _cross )
+            {
+                _cross = Bitboard::popcount( _run );
+                _entry = _run;
+            }
+        }
+        // partner must be able to keep the run while the leader cashes
+        int const   _left{Bitboard::popcount( _hand )};
+        if ( _cross && _quick <= _left - _cross )
+        {
+            win = _entry;
+            enough -= _cross;
+            _quick += _cross;
+        }
+        // the top cards of the runs, only as many as it takes
+        for ( ; _runs && enough > 0; --enough )
+        {
+            Mask const  _card{Mask(1) << (63 - __builtin_clzll( _runs ))};
+            win |= _card;
+            _runs &= ~_card;
+        }
+        return std::min( _quick, _left );
+    }
+
+    //!> legal moves, one card per run of equivalent cards, best first
+    int
+    DDSolver::moves_( int pos, int seat, Trick const& trick, Mask* moves ) const
+    {
+        Mask const  _hand{hands_[seat]};
+        Mask        _legal{_hand};
+        if ( pos > 0 && (_hand & lane( trick.suit )) ) { _legal = _hand & lane( trick.suit ); }
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3] | trick.table};
+        Mask const  _partner{hands_[seat ^ 2]};
+        Mask const  _lho{hands_[(seat + 1) & 3]};
+        Mask const  _rho{hands_[(seat + 3) & 3]};
+        Mask const  _trumps{trump_ == NOTRUMP ? 0 : lane( trump_ )};
+
+        // lowest card of each run: cards already played are gaps that do
+        // not break a run, so add each run start through the gaps above it
+        Mask const  _gaps{Bitboard::ALL & ~_all};
+        Mask const  _span{_legal | _gaps};
+        Mask const  _lowest{(_gaps + (_span & ~(_span << 1))) & _legal};
+
+        std::array<Move, 13>    _moves;
+        int                     _count{0};
+        for ( Mask _cards{_lowest}; _cards; _cards &= _cards - 1 )
+        {
+            int const   _bit{low_bit( _cards )};
+            int const   _suit{_bit >> 4};
+            Mask const  _suited{lane( _suit )};
+            int const   _rank{_bit & 15};
+            Mask const  _above{_all & _suited & ~((Mask(2) << _bit) - 1)};
+            int         _score;
+            if ( pos == 0 )
+            {
+                // winners first, then leads to partner's top card or ruff
+                Mask const  _others{_above & ~_hand};
+                if ( !_others ) { _score = 40; }
+                else if ( (_partner >> (63 - __builtin_clzll( _others )) & 1) ) { _score = 25; }
+                else { _score = (_rho >> (63 - __builtin_clzll( _others )) & 1) ? -25 : 0; }
+                if ( _suit != trump_ && _trumps )
+                {
+                    if ( !(_partner & _suited) && (_partner & _trumps) ) { _score += 30; }
+                    if ( (!(_lho & _suited) && (_lho & _trumps)) || (!(_rho & _suited) && (_rho & _trumps)) ) { _score -= 100; }
+                }
+            }
+            else
+            {
+                bool const  _wins{_suit == (trick.best >> 4) ? _bit > trick.best : _suit == trump_};
+                if ( ((trick.wins ^ seat) & 1) == 0 ) { _score = _wins ? -20 : 20; } // partner is winning
+                else { _score = _wins ? (pos == 1 ? 40 : 60) : 0; }
+                if ( !(_legal & lane( trick.suit )) && !_wins && !(_above & ~_hand) ) { _score -= 15; } // keep winners
+            }
+            Move const  _move{_score - _rank, Mask(1) << _bit};
+            int         _ndx{_count++};
+            for ( ; _ndx > 0 && _moves[_ndx - 1].score < _move.score; --_ndx ) { _moves[_ndx] = _moves[_ndx - 1]; }
+            _moves[_ndx] = _move;
+        }
+        for ( int _ndx{0}; _ndx < _count; ++_ndx ) { moves[_ndx] = _moves[_ndx].card; }
+        return _count;
+    }
+
+    /**
+     * Can North-South take 'target' tricks, with 'won' so far? 'win' gets
+     * the cards whose ranks decided it; the table stores the result for
+     * every position that agrees on those cards and on all lengths.
+     */
+    bool
+    DDSolver::trick_( int leader, int won, int target, Mask& win )
+    {
+        int const   _left{Bitboard::popcount( hands_[leader] )};
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3]};
+        win = 0;
+        if ( won >= target ) { return true; }
+        if ( won + _left < target ) { return false; }
+
+        // the leader's sure winners bound the result either way
+        int const   _quick{quick_( leader, (leader & 1) ? target - won : _left - target + won + 1, win )};
+        if ( (leader & 1) && won + _quick >= target ) { return true; }
+        if ( !(leader & 1) && won + _left - _quick < target ) { return false; }
+
+        // the top trump takes a trick whoever holds it
+        if ( trump_ != NOTRUMP && (_all & lane( trump_ )) )
+        {
+            Mask const  _top{Mask(1) << (63 - __builtin_clzll( _all & lane( trump_ ) ))};
+            bool const  _ours{((hands_[1] | hands_[3]) & _top) != 0};
+            if ( _ours && won + 1 >= target )        { win = _top; return true; }
+            if ( !_ours && won + _left - 1 < target ) { win = _top; return false; }
+        }
+
+        int const       _need{target - won};
+        Position const  _pos{position_( leader )};
+        std::uint16_t const _age{age_};
+        std::uint32_t       _seen[8];   //!< entries that matched without settling it
+        int                 _matched{0};
+        if ( Node* const _node = node_( _pos, false ) )
+        {
+            for ( std::uint32_t _ndx{_node->head}, _prev{0}; _ndx; _prev = _ndx, _ndx = pool_[_ndx - 1].next )
+            {
+                Entry&  _entry(pool_[_ndx - 1]);
+                if ( !_entry.matches( _pos ) ) { continue; }
+                if ( _entry.lb >= _need || _entry.ub < _need )
+                {
+                    // to the front of the chain, where the next look starts
+                    if ( _prev ) { pool_[_prev - 1].next = _entry.next; _entry.next = _node->head; _node->head = _ndx; }
+                    win = top_( _entry.depth );
+                    return _entry.lb >= _need;
+                }
+                if ( _matched < 8 ) { _seen[_matched] = _ndx; }
+                ++_matched;
+            }
+        }
+
+        Trick const _trick{-1, -1, leader, 0};
+        bool const  _made{play_( 0, leader, _trick, won, target, win )};
+
+        // per suit, everything from the top down to the lowest card that mattered
+        Entry           _new;
+        for ( int _suit{0}; _suit < 4; ++_suit )
+        {
+            Mask const  _cards{_all & lane( _suit )};
+            Mask const  _mattered{win & _cards};
+            int const   _depth{_mattered ? Bitboard::popcount( _cards & ~((Mask(1) << low_bit( _mattered )) - 1) ) : 0};
+            _new.depth[_suit] = static_cast<std::uint8_t>(_depth);
+            _new.owners[_suit] = _depth ? _pos.owners[_suit] & ~0u << (32 - 2 * _depth) : 0;
+        }
+        _new.lb = 0;
+        _new.ub = static_cast<std::int8_t>(_left);
+
+        if ( filled_ == pool_.size() ) { clear_(); }
+        Node* const _node{node_( _pos, true )};
+        Entry*      _slot{nullptr};
+        // an entry for the same cards matches this position, so unless the
+        // table started over meanwhile it was one of those seen above
+        if ( age_ == _age && _matched <= 8 )
+        {
+            for ( int _ndx{0}; _ndx < _matched && !_slot; ++_ndx )
+            {
+                if ( pool_[_seen[_ndx] - 1].depth == _new.depth ) { _slot = &pool_[_seen[_ndx] - 1]; }
+            }
+        }
+        else
+        {
+            for ( std::uint32_t _ndx{_node->head}; _ndx && !_slot; _ndx = pool_[_ndx - 1].next )
+            {
+                Entry&  _entry(pool_[_ndx - 1]);
+                if ( _entry.depth == _new.depth && _entry.owners == _new.owners ) { _slot = &_entry; }
+            }
+        }
+        if ( !_slot )
+        {
+            _new.next = _node->head;
+            _slot = &pool_[filled_];
+            *_slot = _new;
+            _node->head = static_cast<std::uint32_t>(++filled_);
+        }
+        if ( _made ) { _slot->lb = static_cast<std::int8_t>(std::max<int>( _slot->lb, _need )); }
+        else         { _slot->ub = static_cast<std::int8_t>(std::min<int>( _slot->ub, _need - 1 )); }
+        return _made;
+    }
+
+    /**
+     * 'win' is the union over the moves tried when all had to be tried,
+     * or that of the move that settled it, plus the winner of the trick
+     * when it won by rank. A card tried for a run of equivalent cards
+     * joins the union when the ranks that mattered reach into its run.
+     */
+    bool
+    DDSolver::play_( int pos, int seat, Trick const& trick, int won, int target, Mask& win )
+    {
+        ++nodes_;
+        Mask        _moves[13];
+        int const   _count{moves_( pos, seat, trick, _moves )};
+        bool const  _ns{(seat & 1) != 0};
+
+        win = 0;
+        Mask const  _all{hands_[0] | hands_[1] | hands_[2] | hands_[3] | trick.table};
+        for ( int _ndx{0}; _ndx < _count; ++_ndx )
+        {
+            Mask const  _card{_moves[_ndx]};
+            int const   _bit{low_bit( _card )};
+            Trick       _next(trick);
+            _next.table |= _card;
+            if ( pos == 0 || ((_bit >> 4) == (trick.best >> 4) ? _bit > trick.best : (_bit >> 4) == trump_) )
+            {
+                if ( pos == 0 ) { _next.suit = _bit >> 4; }
+                _next.best = _bit;
+                _next.wins = seat;
+            }
+
+            hands_[seat] &= ~_card;
+            Mask        _child;
+            bool        _made;
+            if ( pos == 3 )
+            {
+                _made = trick_( _next.wins, won + (_next.wins & 1), target, _child );
+                Mask const  _suited{_next.table & lane( _next.best >> 4 )};
+                if ( _suited & (_suited - 1) ) { _child |= Mask(1) << _next.best; }
+            }
+            else { _made = play_( pos + 1, (seat + 1) & 3, _next, won, target, _child ); }
+            hands_[seat] |= _card;
+
+            if ( _made == _ns ) { win = _child; return _made; } // a win for the side to play
+
+            // the card stood for its run: if ranks that mattered reach into
+            // the run, it is a run only where the card's own rank is kept too
+            Mask const  _over{_all & lane( _bit >> 4 ) & ~hands_[seat] & ~((_card << 1) - 1)};
+            Mask const  _reach{_over ? (_over & (0 - _over)) - 1 : Bitboard::ALL};
+            if ( _child & lane( _bit >> 4 ) & _reach ) { _child |= _card; }
+            win |= _child;
+        }
+        return !_ns;
+    }
+
+    /**
+     * North-South tricks from here: by bisection on the target, or by
+     * steps from a guess (a near result) when there is one.
+     */
+    int
+    DDSolver::solve_( int leader, int guess )
+    {
+        int     _lo{0};
+        int     _hi{Bitboard::popcount( hands_[leader] )};
+        int     _target{guess < 0 ? (_hi + 1) / 2 : guess};
+        Mask    _win;
+        while ( _lo < _hi )
+        {
+            _target = std::min( std::max( _target, _lo + 1 ), _hi );
+            if ( trick_( leader, 0, _target, _win ) ) { _lo = _target; _target = guess < 0 ? (_lo + _hi + 1) / 2 : _target + 1; }
+            else                                      { _hi = _target - 1; _target = guess < 0 ? (_lo + _hi + 1) / 2 : _target - 1; }
+        }
+        return _lo;
+    }
+
+    int
+    DDSolver::tricks( Bitboard const& deal, int declarer, int strain )
+    {
+        if ( declarer < 1 || declarer > 4 || strain < 0 || strain > NOTRUMP || !load_( deal ) ) { return -1; }
+        reset_( strain );
+        int const   _ns{solve_( declarer % 4, -1 )}; // leader is declarer's left
+        return (declarer & 1) == 0 ? _ns : Bitboard::popcount( hands_[0] ) - _ns;
+    }
+
+    int
+    DDSolver::tricks( Deck const& deck, int declarer, int strain )
+    {
+        return tricks( Bitboard(deck), declarer, strain );
+    }
+
+    int
+    DDSolver::tricks( char const* hex, int declarer, int strain )
+    {
+        Bitboard    _deal;
+        return _deal.load_hex( hex ) ? tricks( _deal, declarer, strain ) : -1;
+    }
+
+    // a table is shared by the four leads in a strain
+    DDSolver::Table&
+    DDSolver::table( Bitboard const& deal, Table& out )
+    {
+        for ( auto& _row : out ) { _row.fill( -1 ); }
+        if ( !load_( deal ) ) { return out; }
+        int const   _total{Bitboard::popcount( hands_[0] )};
+        for ( int _strain{0}; _strain <= NOTRUMP; ++_strain )
+        {
+            reset_( _strain );
+            // each result is the guess for the next: W, E, then N, S as declarer
+            int     _ns{-1};
+            for ( int _declarer : {1, 3, 2, 4} )
+            {
+                _ns = solve_( _declarer % 4, _ns );
+                out[_strain][_declarer - 1] = (_declarer & 1) == 0 ? _ns : _total - _ns;
+            }
+        }
+        return out;
+    }
+
+    DDSolver::Table&
+    DDSolver::table( Deck const& deck, Table& out )
+    {
+        return table( Bitboard(deck), out );
+    }
+
+namespace
+{
+    //!> deals taken one at a time by each thread, with a solver of its own
+    template<typename Work>
+    void run_batch( std::size_t count, unsigned threads, Work&& work )
+    {
+        Utility::Parallel::each( count, threads, [&]( Utility::Parallel::Next& next )
+        {
+            DDSolver    _solver;
+            for ( std::size_t _ndx; next( _ndx ); ) { work( _solver, _ndx ); }
+        });
+    }
+}
+
+    void /* static */
+    DDSolver::tricks( Deck const* decks, std::size_t count, int declarer, int strain, int* out, unsigned threads )
+    {
+        run_batch( count, threads, [=]( DDSolver& solver, std::size_t ndx )
+        {
+            out[ndx] = solver.tricks( decks[ndx], declarer, strain );
+        });
+    }
+
+    void /* static */
+    DDSolver::table( Deck const* decks, std::size_t count, Table* out, unsigned threads )
+    {
+        run_batch( count, threads, [=]( DDSolver& solver, std::size_t ndx )
+        {
+            solver.table( decks[ndx], out[ndx] );
+        });
+    }
@@ -0,0 +1,135 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_SOLVER_H
+#define BRIDGE_SOLVER_H
+
+#include "Bitboard.h"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class Deck;
+
+    /**
+     * @class DDSolver
+     * @brief Double dummy tricks for a declarer and strain.
+     * Seats are WNES 1..4 as in Deck; strains are the suits SHDC 0..3
+     * and NOTRUMP. The opening lead is from declarer's left.
+     *
+     * Each solver owns a transposition table, so a solver must not be
+     * shared between threads; the batch functions make one per thread.
+     * Deals with fewer than 13 cards a hand (all hands equal) are solved
+     * for the tricks that remain.
+     *
+     * The search is a sequence of null window alpha-beta searches ("can
+     * North-South take t tricks?") narrowing on the result. Positions at
+     * the start of each trick are kept in the table with bounds on the
+     * North-South tricks still to come, so they serve any target and both
+     * declarers of a side. An entry covers every position with the same
+     * suit lengths in each hand that agrees on the cards whose ranks
+     * decided the result (Haglund's "winning ranks"); the rest count as
+     * small cards. The leader's top winners cut the search short, only
+     * one card of a run of equivalent cards is tried, and moves are
+     * ordered so that cheap winners and ruffs come first.
+     */
+    class DDSolver
+    {
+    public:
+        enum { NOTRUMP = 4 };
+        using Table = std::array<std::array<int, 4>, 5>; //!< [strain][declarer - 1], -1 if invalid
+
+        ~DDSolver() noexcept = default;
+        //!> table of 2^bits entries (28 bytes each)
+        explicit
+        DDSolver(unsigned bits = 19);
+
+        //!> tricks for declarer, -1 if the deal is not valid
+        int tricks( Deck const&, int declarer, int strain );
+        int tricks( char const* hex, int declarer, int strain );
+        int tricks( Bitboard const&, int declarer, int strain );
+
+        //!> all 20 results
+        Table& table( Deck const&, Table& );
+        Table& table( Bitboard const&, Table& );
+
+        std::uint64_t nodes() const { return nodes_; }
+
+        //!> batch: deals spread across 'threads' solvers (0: all cores)
+        static void tricks( Deck const* decks, std::size_t count, int declarer, int strain,
+                            int* out, unsigned threads = 0 );
+        static void table( Deck const* decks, std::size_t count, Table* out, unsigned threads = 0 );
+
+    private:
+        using Mask = Bitboard::Mask;
+
+        struct Position
+        {
+            std::uint64_t                   lengths{0}; //!< 4 bits per hand and suit
+            std::array<std::uint32_t, 4>    owners{{0, 0, 0, 0}};
+            int                             leader{0};
+        };
+        //!> positions with the same lengths and leader share a chain of entries
+        struct Node
+        {
+            std::uint64_t   lengths{0};
+            std::uint32_t   head{0};    //!< first entry + 1, 0 if none
+            std::uint16_t   age{0};
+            std::uint8_t    leader{0};
+        };
+        //!> bounds for positions that agree on the top 'depth' cards of each suit
+        struct Entry
+        {
+            std::array<std::uint32_t, 4>    owners{{0, 0, 0, 0}};
+            std::array<std::uint8_t, 4>     depth{{0, 0, 0, 0}};
+            std::uint32_t                   next{0};
+            std::int8_t                     lb{0};  //!< bounds on North-South tricks to come
+            std::int8_t                     ub{0};
+
+            bool matches( Position const& pos ) const
+            {
+                for ( int _suit{0}; _suit < 4; ++_suit )
+                {
+                    if ( depth[_suit] && (pos.owners[_suit] & ~0u << (32 - 2 * depth[_suit])) != owners[_suit] ) { return false; }
+                }
+                return true;
+            }
+        };
+        struct Trick
+        {
+            int     suit;   //!< suit led
+            int     best;   //!< bit of the winning card so far
+            int     wins;   //!< seat index of that card
+            Mask    table;  //!< cards played to this trick
+        };
+
+        std::vector<Node>       table_;
+        std::vector<Entry>      pool_;
+        std::size_t             mask_;      //!< table size - 1
+        std::size_t             used_{0};   //!< nodes in use
+        std::size_t             filled_{0}; //!< entries in use
+        std::uint16_t           age_{0};
+        std::array<Mask, 4>     hands_{{0, 0, 0, 0}}; //!< W N E S
+        int                     trump_{NOTRUMP};
+        std::uint64_t           nodes_{0};
+
+        bool load_( Bitboard const& );
+        void reset_( int strain );
+        void clear_();
+        int  solve_( int leader, int guess );
+        bool trick_( int leader, int won, int target, Mask& win );
+        bool play_( int pos, int seat, Trick const& trick, int won, int target, Mask& win );
+        int  quick_( int leader, int enough, Mask& win ) const;
+        int  moves_( int pos, int seat, Trick const& trick, Mask* moves ) const;
+        Position position_( int leader ) const;
+        Node*    node_( Position const&, bool add );
+        Mask     top_( std::array<std::uint8_t, 4> const& depth ) const;
+    };
+
+#endif // BRIDGE_SOLVER_H
@@ -0,0 +1,111 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Symmetry.h"
+#include "Deck.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    inline
+    bool less( Bitboard const& one, Bitboard const& two )
+    {
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            if ( one.hand( _seat ) != two.hand( _seat ) ) { return one.hand( _seat ) < two.hand( _seat ); }
+        }
+        return false;
+    }
+}
+
+    Bitboard /* static */
+    DealSymmetry::apply( Bitboard const& deal, Transform const& t )
+    {
+        Bitboard    _image;
+        for ( int _seat{1}; _seat <= 4; ++_seat )
+        {
+            Bitboard::Mask  _hand{0};
+            for ( int _suit{0}; _suit < 4; ++_suit )
+            {
+                _hand |= Bitboard::Mask(deal.holding( seat( t, _seat ), t.suits[_suit] )) << (16 * _suit);
+            }
+            _image.hand( _seat ) = _hand;
+        }
+        return _image;
+    }
+
+    /**
+     * The suit in the highest lane weighs most, so for each rotation the
+     * suits go in descending order of their holdings W, N, E, S (13 bits
+     * each): the least ends up in the clubs lane.
+     */
+    Bitboard /* static */
+    DealSymmetry::canonical( Bitboard const& deal, int mode, Transform* out )
+    {
+        Bitboard    _best{deal};
+        Transform   _which;
+        for ( int _rotate{0}; _rotate < ((mode & ROTATE) ? 4 : 1); ++_rotate )
+        {
+            Transform   _t;
+            _t.rotate = _rotate;
+            if ( mode & SUITS )
+            {
+                std::array<std::uint64_t, 4>    _sig;
+                for ( int _suit{0}; _suit < 4; ++_suit )
+                {
+                    _sig[_suit] = std::uint64_t(deal.holding( seat( _t, 1 ), _suit )) << 39
+                                | std::uint64_t(deal.holding( seat( _t, 2 ), _suit )) << 26
+                                | std::uint64_t(deal.holding( seat( _t, 3 ), _suit )) << 13
+                                | std::uint64_t(deal.holding( seat( _t, 4 ), _suit ));
+                }
+                std::sort( _t.suits.begin(), _t.suits.end(), [&]( int a, int b ) { return _sig[a] > _sig[b]; } );
+            }
+            Bitboard const  _image(apply( deal, _t ));
+            if ( _rotate == 0 || less( _image, _best ) )
+            {
+                _best  = _image;
+                _which = _t;
+            }
+        }
+        if ( out ) { *out = _which; }
+        return _best;
+    }
+
+    bool /* static */
+    DealSymmetry::key( DealNumber::Key& key, Deck const& deck, int mode, Transform* t )
+    {
+        Bitboard const  _deal(deck);
+        if ( !_deal.complete() ) { return false; }
+        Deck                _canon;
+        DealNumber::Number  _num;
+        if ( !DealNumber::rank( _num, canonical( _deal, mode, t ).to_deck( _canon ) ) ) { return false; }
+        key = DealNumber::to_key( _num );
+        return true;
+    }
+
+    std::size_t /* static */
+    DealSymmetry::keys( DealNumber::Key* keys, Deck const* decks, std::size_t count, int mode,
+                        Transform* transforms, bool* ok, unsigned threads )
+    {
+        std::vector<std::size_t>    _valid(Utility::Parallel::threads( threads, count, 1024 ), 0);
+        Utility::Parallel::slices( count, threads, 1024, [=, &_valid]( std::size_t begin, std::size_t end, unsigned slice )
+        {
+            std::size_t _count{0};
+            for ( std::size_t _ndx{begin}; _ndx < end; ++_ndx )
+            {
+                bool const  _ok{key( keys[_ndx], decks[_ndx], mode, transforms ? transforms + _ndx : nullptr )};
+                if ( ok ) { ok[_ndx] = _ok; }
+                _count += _ok;
+            }
+            _valid[slice] = _count;
+        });
+        std::size_t _total{0};
+        for ( auto _part : _valid ) { _total += _part; }
+        return _total;
+    }
@@ -0,0 +1,59 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_SYMMETRY_H
+#define BRIDGE_SYMMETRY_H
+
+#include "Bitboard.h"
+#include "DealNumber.h"
+
+#include <array>
+#include <cstddef>
+
+class Deck;
+
+    /**
+     * @class DealSymmetry
+     * @brief One representative for deals that differ only by seat rotation
+     * and/or a renaming of the suits.
+     * The canonical deal is the least of the (up to 96) images, comparing
+     * the Bitboard hands W, N, E, S in turn. For a given rotation the best
+     * suit order is found by sorting the suits on their four holdings, so
+     * the cost is four sorts of four, not 96 images.
+     *
+     * The Transform says how the canonical deal was made, so a result kept
+     * for it (a double dummy table, say) can be read back for the deal in
+     * hand: canonical seat s is seat(t, s) of the original, canonical suit
+     * k is suit(t, k). Suit renaming keeps only strain-agnostic results
+     * valid unless they are remapped this way.
+     */
+    class DealSymmetry
+    {
+    public:
+        enum Mode { ROTATE = 1, SUITS = 2, BOTH = 3 };
+
+        struct Transform
+        {
+            int                 rotate{0};              //!< 0..3 seats
+            std::array<int, 4>  suits{{0, 1, 2, 3}};    //!< original suit at each canonical suit
+        };
+
+        static Bitboard  apply( Bitboard const&, Transform const& );
+        static Bitboard  canonical( Bitboard const&, int mode = BOTH, Transform* = nullptr );
+
+        //!> original seat (WNES 1..4) and suit (SHDC 0..3) for canonical ones
+        static int seat( Transform const& t, int seat ) { return (seat - 1 + t.rotate) % 4 + 1; }
+        static int suit( Transform const& t, int suit ) { return t.suits[suit & 3]; }
+
+        //!> DealNumber key of the canonical deal; false if not a full deal
+        static bool key( DealNumber::Key&, Deck const&, int mode = BOTH, Transform* = nullptr );
+        //!> batch; returns the number of valid deals, ok[i] (if given) per deal
+        static std::size_t keys( DealNumber::Key* keys, Deck const* decks, std::size_t count, int mode = BOTH,
+                                 Transform* transforms = nullptr, bool* ok = nullptr, unsigned threads = 0 );
+    };
+
+#endif // BRIDGE_SYMMETRY_H
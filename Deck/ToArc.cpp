@@ -0,0 +1,108 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "Codec.h"
+#include "Deal.h"
+#include "DealArchive.h"
+#include "CharBuffer.h"
+
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+    /**
+     * ToArc: hex hand records <-> binary archive.
+     *   ToArc [-r] file.arc < hex   build an archive (-r: 12-byte deal numbers)
+     *   ToArc -x file.arc [board...] list records (all, or by board)
+     * Input lines are "HEX" or "HEX-d" (d = dealer/vulnerability digit),
+     * optionally preceded by "board:". Boards default to 1, 2, 3...
+     */
+
+int build( char const* file, DealArchive::Format fmt )
+{
+    ArchiveWriter   _arc(file, fmt);
+    if ( !_arc )
+    {
+        std::cerr << "Cannot create " << file << ": " << ::strerror( _arc.error() ) << "\n";
+        return 1;
+    }
+    std::string     _line;
+    int             _board{0};
+    int             _lineno{0};
+    while ( std::getline( std::cin, _line ) )
+    {
+        ++_lineno;
+        char const* _hex{_line.c_str()};
+        char*       _end;
+        long        _num{std::strtol( _hex, &_end, 10 )};
+        if ( *_end == ':' )
+        {
+            _board = static_cast<int>(_num);
+            _hex = _end + 1;
+        }
+        else { ++_board; }
+
+        int         _dv{-1};
+        if ( _line.size() - (_hex - _line.c_str()) > 27 && _hex[26] == '-' )
+        {
+            char const  _dig[2] = { _hex[27], '\0' };
+            _dv = static_cast<int>(std::strtol( _dig, nullptr, 16 ));
+        }
+        if ( !_arc.add_hex( _hex, _board, _dv ) )
+        {
+            std::cerr << "Line " << _lineno << ": not a valid record: " << _line << "\n";
+        }
+    }
+    if ( !_arc.close() )
+    {
+        std::cerr << "Error writing " << file << ": " << ::strerror( _arc.error() ) << "\n";
+        return 1;
+    }
+    std::cerr << _arc.size() << " records\n";
+    return 0;
+}
+
+void show( ArchiveReader::Entry const& entry, std::ostream& os )
+{
+    os << entry.board() << ':' << Buffer32(&ArchiveReader::Entry::store_hex, entry).get()
+       << '-' << DeckCodec::hex_digit( entry.dv() ) << '\n';
+}
+
+int extract( char const* file, int ac, char const* av[] )
+{
+    ArchiveReader   _arc(file);
+    if ( !_arc )
+    {
+        std::cerr << "Cannot read " << file << ": " << ::strerror( _arc.error() ) << "\n";
+        return 1;
+    }
+    if ( ac == 0 )
+    {
+        for ( auto const& _entry : _arc ) { show( _entry, std::cout ); }
+    }
+    else
+    for ( int _ndx{0}; _ndx < ac; ++_ndx )
+    {
+        std::size_t _rec;
+        if ( _arc.find( std::atoi( av[_ndx] ), _rec ) ) { show( _arc.at( _rec ), std::cout ); }
+        else { std::cerr << "No board " << av[_ndx] << "\n"; }
+    }
+    std::cout.flush();
+    return 0;
+}
+
+int main( int ac, char const* av[] )
+{
+    if ( ac > 2 && !::strcmp( av[1], "-x" ) ) { return extract( av[2], ac - 3, av + 3 ); }
+    if ( ac > 2 && !::strcmp( av[1], "-r" ) ) { return build( av[2], DealArchive::Format::RANK ); }
+    if ( ac > 1 && *av[1] != '-' ) { return build( av[1], DealArchive::Format::HEX ); }
+
+    std::cerr << "Usage: " << av[0] << " [-r] file.arc < hex\n"
+              << "       " << av[0] << " -x file.arc [board...]\n";
+    return 2;
+}
@@ -0,0 +1,365 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "Codec.h"
+#include "Deal.h"
+#include "DealWriter.h"
+#include "Converter.h"
+#include "CharBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <unistd.h>
+
+    /**
+     * ToFmt: bulk conversion between deal formats, one deal per line.
+     *   ToFmt [-f fmt] [-t fmt] [-d W|N|E|S] [-j threads] [file]
+     * fmt is one of hex, lin, pbn, bhg. The input format is guessed from
+     * the first line if not given; the output defaults to pbn. The dealer
+     * is for inputs that do not carry one, and cycles by line as in ToPbn.
+     * The file is memory mapped; with no file, STDIN is read into memory.
+     *   ToFmt -b [file]
+     * times DealWriter on hex deals against the Deal and snprintf path it
+     * replaced, for pbn, lin and GIB records, and checks they agree; then
+     * sizes and JSON round trips for each Deck::Wire form; then runs the
+     * batch hex decoder on every DeckCodec kernel the cpu has, on the deals
+     * and damaged copies of them, and checks each agrees with the scalar one.
+     */
+
+namespace legacy
+{
+    using Buf20 = Utility::CharBuffer<20>;
+
+    char* store_pbn_s( char* buf, std::size_t len, Deck const& deck, int dlr )
+    {
+        Deal const  _deal(deck.begin());
+        Buf20       _w(&Deal::store_pbn, _deal[0]);
+        Buf20       _n(&Deal::store_pbn, _deal[1]);
+        Buf20       _e(&Deal::store_pbn, _deal[2]);
+        Buf20       _s(&Deal::store_pbn, _deal[3]);
+        char const* _fmt{"%c:%s %s %s %s"};
+
+        switch ( dlr % 4 )
+        {
+        case 0: return buf + ::snprintf( buf, len, _fmt, 'S', _s.get(), _w.get(), _n.get(), _e.get());
+        case 1: return buf + ::snprintf( buf, len, _fmt, 'W', _w.get(), _n.get(), _e.get(), _s.get());
+        case 2: return buf + ::snprintf( buf, len, _fmt, 'N', _n.get(), _e.get(), _s.get(), _w.get());
+        default: return buf + ::snprintf( buf, len, _fmt, 'E', _e.get(), _s.get(), _w.get(), _n.get());
+        }
+    }
+
+    char* store_lin_s( char* buf, std::size_t len, Deck const& deck, int dlr )
+    {
+        Deal const  _deal(deck.begin());
+        Buf20       _s(&Deal::store_lin, _deal[3]);
+        Buf20       _w(&Deal::store_lin, _deal[0]);
+        Buf20       _n(&Deal::store_lin, _deal[1]);
+        return buf + ::snprintf( buf, len, "%c%s,%s,%s", "1234"[dlr % 4], _s.get(), _w.get(), _n.get());
+    }
+
+    char* store_hrdv( char* buf, std::size_t len, char const* hex, int dlr, int vul )
+    {
+        Deal const  _deal(hex);
+        Buffer32    _w(&Deal::store_pbn, _deal[0]);
+        Buffer32    _n(&Deal::store_pbn, _deal[1]);
+        Buffer32    _e(&Deal::store_pbn, _deal[2]);
+        Buffer32    _s(&Deal::store_pbn, _deal[3]);
+        return buf + ::snprintf( buf, len, "%s %s %s %s %c %c", _n.get(), _e.get(), _s.get(), _w.get(), "SWNE"[dlr % 4], "B-NE"[vul % 4] );
+    }
+}
+
+bool to_format( Deck::Format& fmt, char const* name )
+{
+    if ( !::strcasecmp( name, "hex" ) ) { fmt = Deck::Format::HEX; return true; }
+    if ( !::strcasecmp( name, "lin" ) ) { fmt = Deck::Format::LIN; return true; }
+    if ( !::strcasecmp( name, "pbn" ) ) { fmt = Deck::Format::PBN; return true; }
+    if ( !::strcasecmp( name, "bhg" ) ) { fmt = Deck::Format::BHG; return true; }
+    return false;
+}
+
+bool guess_format( Deck::Format& fmt, char const* buf, std::size_t len )
+{
+    char const* _eol = static_cast<char const*>(::memchr( buf, '\n', len ));
+    return Converter::detect( fmt, buf, _eol ? _eol : buf + len );
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-f hex|lin|pbn|bhg] [-t hex|lin|pbn|bhg] [-d W|N|E|S] [-j threads] [file]\n"
+              << "       " << prog << " -b [file]\n";
+    return 2;
+}
+
+//!> every kernel on the same records; the number of records on which one differs from SCALAR
+std::size_t codec_check( std::vector<std::string> const& hexes )
+{
+    using Clock  = std::chrono::steady_clock;
+    using Kernel = DeckCodec::Kernel;
+    std::size_t const   _stride{27};
+
+    // each deal, then a copy with a bad hexit and one with a card moved to another seat
+    std::string     _buf;
+    for ( auto const& _hex : hexes )
+    {
+        for ( int _copy{0}; _copy < 3; ++_copy )
+        {
+            std::string _rec(_hex);
+            std::size_t const   _at{_buf.size() / _stride % 26};
+            if ( _copy == 1 ) { _rec[_at] = 'G'; }
+            if ( _copy == 2 ) { _rec[_at] = DeckCodec::hex_digit( DeckCodec::hex_value( _rec[_at] ) ^ 1 ); }
+            _buf.append( _rec ).push_back( '\n' );
+        }
+    }
+    std::size_t const   _count{_buf.size() / _stride};
+    Kernel const        _best{DeckCodec::kernel()};
+
+    struct Run
+    {
+        std::vector<Deck>       decks;
+        std::unique_ptr<bool[]> ok;
+        std::unique_ptr<bool[]> verified;
+        std::vector<Deck>       lines;
+        std::unique_ptr<bool[]> lines_ok;
+        std::string             encoded;
+        std::size_t             valid{0};
+    };
+    auto    _run([&]( Run& run ) -> double
+    {
+        run.decks.assign( _count, Deck() );
+        run.lines.assign( _count, Deck() );
+        run.ok.reset( new bool[_count] );
+        run.verified.reset( new bool[_count] );
+        run.lines_ok.reset( new bool[_count] );
+        auto const  _t0(Clock::now());
+        run.valid = DeckCodec::decode_hex( run.decks.data(), _buf.data(), _count, _stride, run.ok.get() );
+        auto const  _t1(Clock::now());
+        DeckCodec::verify_hex( run.verified.get(), _buf.data(), _count, _stride );
+        DeckCodec::decode_lines( run.lines.data(), _count, _buf.data(), _buf.size(), Deck::Format::HEX, run.lines_ok.get() );
+        run.encoded.assign( _buf.size(), '\0' );
+        std::vector<Deck>   _good;
+        for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx ) { if ( run.ok[_ndx] ) { _good.push_back( run.decks[_ndx] ); } }
+        run.encoded.resize( _good.size() * _stride );
+        DeckCodec::encode_hex( &run.encoded[0], _good.data(), _good.size(), _stride );
+        return std::chrono::duration<double>(_t1 - _t0).count();
+    });
+
+    Run             _scalar;
+    DeckCodec::kernel( Kernel::SCALAR );
+    double const    _base{_run( _scalar )};
+    std::size_t     _differ{0};
+    std::cout << "codec records: " << _count << ", valid: " << _scalar.valid << ", " << DeckCodec::kernel_name( Kernel::SCALAR ) << " "
+              << (_count / _base) << " decodes/sec\n";
+    for ( Kernel _kernel : { Kernel::SSE41, Kernel::AVX2 } )
+    {
+        DeckCodec::kernel( _kernel );
+        if ( DeckCodec::kernel() != _kernel )
+        {
+            std::cout << DeckCodec::kernel_name( _kernel ) << ": not on this cpu\n";
+            continue;
+        }
+        Run             _simd;
+        double const    _secs{_run( _simd )};
+        std::size_t     _diff{0};
+        for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+        {
+            bool const  _ok{_scalar.ok[_ndx]};
+            _diff += _simd.ok[_ndx] != _ok || _simd.verified[_ndx] != _scalar.verified[_ndx]
+                  || _simd.lines_ok[_ndx] != _scalar.lines_ok[_ndx] || _scalar.verified[_ndx] != _ok
+                  || (_ok && (!std::equal( _simd.decks[_ndx].begin(), _simd.decks[_ndx].end(), _scalar.decks[_ndx].begin() )
+                           || !std::equal( _simd.lines[_ndx].begin(), _simd.lines[_ndx].end(), _scalar.decks[_ndx].begin() )));
+        }
+        _diff += _simd.encoded != _scalar.encoded || _simd.valid != _scalar.valid;
+        _differ += _diff;
+        std::cout << DeckCodec::kernel_name( _kernel ) << ": " << (_count / _secs) << " decodes/sec (x" << (_base / _secs) << ")"
+                  << (_diff ? "  (MISMATCH)" : "") << "\n";
+    }
+    DeckCodec::kernel( _best );
+    return _differ;
+}
+
+int benchmark( std::istream& in )
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<Deck>           _decks;
+    std::vector<std::string>    _hexes;
+    std::string                 _line;
+    while ( std::getline( in, _line ) )
+    {
+        if ( !_line.empty() && _line.back() == '\r' ) { _line.pop_back(); }
+        Deck    _deck;
+        if ( _line.size() < 26 || !_deck.load_hex( _line.c_str() ) ) { continue; }
+        _decks.push_back( _deck );
+        _hexes.emplace_back( _line, 0, 26 );
+    }
+
+    std::size_t const   _count{_decks.size()};
+    std::vector<char>   _old(_count * DealWriter::LENGTH);
+    std::vector<char>   _new(_count * DealWriter::LENGTH);
+    std::size_t         _bad{0};
+    auto                _time([&]( char const* name, auto&& before, auto&& after )
+    {
+        auto const  _t0(Clock::now());
+        for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx ) { before( &_old[_ndx * DealWriter::LENGTH], _ndx ); }
+        auto const  _t1(Clock::now());
+        for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx ) { after( &_new[_ndx * DealWriter::LENGTH], _ndx ); }
+        auto const  _t2(Clock::now());
+        std::size_t _diff{0};
+        for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+        {
+            _diff += std::strcmp( &_old[_ndx * DealWriter::LENGTH], &_new[_ndx * DealWriter::LENGTH] ) != 0;
+        }
+        _bad += _diff;
+        double const    _slow{std::chrono::duration<double>(_t1 - _t0).count()};
+        double const    _fast{std::chrono::duration<double>(_t2 - _t1).count()};
+        std::cout << name << ": snprintf " << (_count / _slow) << " deals/sec, direct "
+                  << (_count / _fast) << " deals/sec (x" << (_slow / _fast) << ")"
+                  << (_diff ? "  (MISMATCH)" : "") << "\n";
+    });
+
+    std::size_t const   _len{DealWriter::LENGTH};
+    std::cout << "deals: " << _count << "\n";
+    _time( "pbn",
+           [&]( char* buf, std::size_t ndx ) { legacy::store_pbn_s( buf, _len, _decks[ndx], int(ndx) ); },
+           [&]( char* buf, std::size_t ndx ) { DealWriter::pbn( buf, _len, _decks[ndx], int(ndx) ); } );
+    _time( "lin",
+           [&]( char* buf, std::size_t ndx ) { legacy::store_lin_s( buf, _len, _decks[ndx], int(ndx) ); },
+           [&]( char* buf, std::size_t ndx ) { DealWriter::lin( buf, _len, _decks[ndx], int(ndx) ); } );
+    _time( "gib",
+           [&]( char* buf, std::size_t ndx ) { legacy::store_hrdv( buf, _len, _hexes[ndx].c_str(), int(ndx), int(ndx / 4) ); },
+           [&]( char* buf, std::size_t ndx ) { Deal::store_hrdv( buf, _len, _hexes[ndx].c_str(), int(ndx), int(ndx / 4) ); } );
+
+    // the Deck wire forms: size as JSON text, CBOR and MessagePack, and round trips through text
+    char const* const   _names[] = { "array", "hex", "packed" };
+    for ( auto _wire : { Deck::Wire::ARRAY, Deck::Wire::HEX, Deck::Wire::PACKED } )
+    {
+        std::size_t     _text{0};
+        std::size_t     _cbor{0};
+        std::size_t     _pack{0};
+        std::size_t     _diff{0};
+        auto const      _t0(Clock::now());
+        for ( auto const& _deck : _decks )
+        {
+            nlohmann::json  _js;
+            _deck.to_js( _js, _wire );
+            std::string const   _dump(_js.dump());
+            Deck    _back;
+            _back.fr_js( nlohmann::json::parse( _dump ) );
+            _diff += !std::equal( _back.begin(), _back.end(), _deck.begin() );
+            _text += _dump.size();
+        }
+        auto const      _t1(Clock::now());
+        for ( auto const& _deck : _decks )
+        {
+            _cbor += _deck.to_bin( _wire, Deck::Binary::CBOR ).size();
+            _pack += _deck.to_bin( _wire, Deck::Binary::MSGPACK ).size();
+        }
+        _bad += _diff;
+        double const    _secs{std::chrono::duration<double>(_t1 - _t0).count()};
+        std::cout << _names[int(_wire)] << ": bytes/deck json " << (double(_text) / _count)
+                  << " cbor " << (double(_cbor) / _count) << " msgpack " << (double(_pack) / _count)
+                  << ", json round trips/sec " << (_count / _secs)
+                  << (_diff ? "  (MISMATCH)" : "") << "\n";
+    }
+    _bad += codec_check( _hexes );
+    std::cout << std::flush;
+    return _bad ? 1 : 0;
+}
+
+int main( int ac, char* av[] )
+{
+    Converter::Options  _opts;
+    bool                _from{false};
+    bool                _bench{false};
+    int                 _opt;
+
+    while ( (_opt = ::getopt( ac, av, "f:t:d:j:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'f':
+            if ( !to_format( _opts.from, ::optarg ) ) { return usage( av[0] ); }
+            _from = true;
+            break;
+        case 't':
+            if ( !to_format( _opts.to, ::optarg ) ) { return usage( av[0] ); }
+            break;
+        case 'd':
+            if ( !::strchr( "WNESwnes", *::optarg ) || !*::optarg ) { return usage( av[0] ); }
+            _opts.dealer = static_cast<int>(::strchr( "WNES", ::toupper( *::optarg ) ) - "WNES") + 1;
+            break;
+        case 'j': _opts.threads = static_cast<unsigned>(std::atoi( ::optarg )); break;
+        case 'b': _bench = true; break;
+        default: return usage( av[0] );
+        }
+    }
+    if ( _bench )
+    {
+        if ( ::optind >= ac )
+        {
+            std::cerr << "Reading from STDIN\n";
+            return benchmark( std::cin );
+        }
+        std::ifstream   _in(av[::optind]);
+        if ( !_in )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+        return benchmark( _in );
+    }
+
+    Converter::Stats    _stats;
+    if ( ::optind < ac )
+    {
+        char const*     _file{av[::optind]};
+        if ( !_from )
+        {
+            Buffer<256>     _head;
+            if ( std::FILE* _fp = std::fopen( _file, "r" ) )
+            {
+                if ( !std::fgets( _head.get(), 256, _fp ) ) { _head.reset(); }
+                std::fclose( _fp );
+            }
+            if ( !guess_format( _opts.from, _head.get(), _head.size() ) )
+            {
+                std::cerr << "Cannot tell the input format of " << _file << "\n";
+                return 1;
+            }
+        }
+        _stats = Converter::convert( _file, stdout, _opts );
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        std::string     _input{std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()};
+        if ( !_from && !guess_format( _opts.from, _input.data(), _input.size() ) )
+        {
+            std::cerr << "Cannot tell the input format\n";
+            return 1;
+        }
+        _stats = Converter::convert( _input.data(), _input.size(), stdout, _opts );
+    }
+
+    if ( _stats.io_error )
+    {
+        std::cerr << "I/O error: " << ::strerror( _stats.io_error ) << "\n";
+        return 1;
+    }
+    std::cerr << _stats.deals << " deals, " << _stats.errors << " errors";
+    if ( _stats.errors ) { std::cerr << " (first at line " << _stats.first_error << ")"; }
+    std::cerr << std::endl;
+    return _stats.errors ? 1 : 0;
+}
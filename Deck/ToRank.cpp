@@ -0,0 +1,194 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Deck.h"
+#include "DealNumber.h"
+#include "Symmetry.h"
+#include "Bitboard.h"
+#include "CharBuffer.h"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+    /**
+     * ToRank: HEX <-> 96-bit deal number (24 hex digits).
+     *   ToRank [hex ...]        hex -> number
+     *   ToRank -u [number ...]  number -> hex
+     *   ToRank -c [hex ...]     hex -> number of the canonical deal, the same
+     *                           for all seat rotations and suit renamings
+     *   ToRank -b [count]       rank/unrank/canonical benchmark over random deals
+     * With no operands, reads lines from STDIN.
+     */
+
+void to_number( char const* arg, std::ostream& os )
+{
+    Deck                _deck;
+    DealNumber::Number  _num;
+    if ( !_deck.load_hex( arg ) || !DealNumber::rank( _num, _deck ) )
+    {
+        std::cerr << "Not a valid HEX deal-string: " << arg << "\n";
+        return;
+    }
+    Buffer32            _key;
+    DealNumber::store_key( _key.get(), 32, _num );
+    os << _key.get() << '\n';
+}
+
+void to_canonical( char const* arg, std::ostream& os )
+{
+    Deck                _deck;
+    DealNumber::Key     _key;
+    if ( !_deck.load_hex( arg ) || !DealSymmetry::key( _key, _deck ) )
+    {
+        std::cerr << "Not a valid HEX deal-string: " << arg << "\n";
+        return;
+    }
+    Buffer32            _buf;
+    DealNumber::store_key( _buf.get(), 32, DealNumber::fr_key( _key ) );
+    os << _buf.get() << '\n';
+}
+
+//!> the least of all 96 images, the long way
+Bitboard brute_canonical( Bitboard const& deal )
+{
+    Bitboard                    _best(deal);
+    DealSymmetry::Transform     _t;
+    for ( _t.rotate = 0; _t.rotate < 4; ++_t.rotate )
+    {
+        _t.suits = {{0, 1, 2, 3}};
+        do
+        {
+            Bitboard const  _image(DealSymmetry::apply( deal, _t ));
+            for ( int _seat{1}; _seat <= 4; ++_seat )
+            {
+                if ( _image.hand( _seat ) == _best.hand( _seat ) ) { continue; }
+                if ( _image.hand( _seat ) < _best.hand( _seat ) ) { _best = _image; }
+                break;
+            }
+        } while ( std::next_permutation( _t.suits.begin(), _t.suits.end() ) );
+    }
+    return _best;
+}
+
+void to_hex( char const* arg, std::ostream& os )
+{
+    Deck                _deck;
+    DealNumber::Number  _num;
+    if ( !DealNumber::load_key( _num, arg ) || !DealNumber::unrank( _deck, _num ) )
+    {
+        std::cerr << "Not a valid deal number: " << arg << "\n";
+        return;
+    }
+    os << Buffer32(&Deck::store_hex, _deck).get() << '\n';
+}
+
+int benchmark( std::size_t count )
+{
+    using Clock = std::chrono::steady_clock;
+    auto    _usecs([]( Clock::time_point t0 )
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    });
+
+    std::mt19937_64         _rng(52);
+    std::vector<Deck>       _decks(count);
+    std::array<int, 52>     _cards;
+    for ( int _slot{0}; _slot < 52; ++_slot ) { _cards[_slot] = 1 + _slot / 13; }
+    for ( auto& _deck : _decks )
+    {
+        std::shuffle( _cards.begin(), _cards.end(), _rng );
+        std::copy( _cards.begin(), _cards.end(), _deck.begin() );
+    }
+
+    std::vector<DealNumber::Number> _nums(count);
+    std::vector<Deck>               _back(count);
+
+    auto        _t0(Clock::now());
+    std::size_t _ranked{DealNumber::rank( _nums.data(), _decks.data(), count )};
+    double      _rank{_usecs( _t0 )};
+
+    _t0 = Clock::now();
+    std::size_t _unranked{DealNumber::unrank( _back.data(), _nums.data(), count )};
+    double      _unrank{_usecs( _t0 )};
+
+    std::vector<DealNumber::Key>            _keys(count);
+    std::vector<DealSymmetry::Transform>    _how(count);
+    _t0 = Clock::now();
+    DealSymmetry::keys( _keys.data(), _decks.data(), count, DealSymmetry::BOTH, _how.data(), nullptr, 1 );
+    double      _canon{_usecs( _t0 )};
+
+    std::size_t _bad{0};
+    for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+    {
+        if ( !std::equal( _decks[_ndx].begin(), _decks[_ndx].end(), _back[_ndx].begin() ) ) { ++_bad; }
+    }
+    // canonical: the least image, and the same key from a shuffled image
+    std::size_t _odd{0};
+    for ( std::size_t _ndx{0}; _ndx < std::min<std::size_t>( count, 10000 ); ++_ndx )
+    {
+        Bitboard const              _deal(_decks[_ndx]);
+        DealSymmetry::Transform     _t;
+        _t.rotate = static_cast<int>(_rng() % 4);
+        std::shuffle( _t.suits.begin(), _t.suits.end(), _rng );
+        Deck                        _other;
+        DealNumber::Key             _key;
+        DealSymmetry::apply( _deal, _t ).to_deck( _other );
+        if ( !DealSymmetry::key( _key, _other ) || _key != _keys[_ndx]
+          || DealSymmetry::apply( _deal, _how[_ndx] ) != brute_canonical( _deal ) ) { ++_odd; }
+    }
+
+    std::cout << "deals: " << count << " ranked: " << _ranked << " unranked: " << _unranked
+              << " mismatches: " << _bad << " canonical mismatches: " << _odd << "\n"
+              << "rank:   " << (_rank * 1000.0 / count) << " ns/deal\n"
+              << "unrank: " << (_unrank * 1000.0 / count) << " ns/deal\n"
+              << "canonical key: " << (_canon * 1000.0 / count) << " ns/deal" << std::endl;
+    return _bad || _odd ? 1 : 0;
+}
+
+int main( int ac, char const* av[] )
+{
+    auto    _process(&to_number);
+    int     _first{1};
+
+    if ( ac > 1 && !::strcmp( av[1], "-b" ) )
+    {
+        return benchmark( ac > 2 ? std::strtoul( av[2], nullptr, 10 ) : 1000000 );
+    }
+    if ( ac > 1 && !::strcmp( av[1], "-u" ) )
+    {
+        _process = &to_hex;
+        ++_first;
+    }
+    else if ( ac > 1 && !::strcmp( av[1], "-c" ) )
+    {
+        _process = &to_canonical;
+        ++_first;
+    }
+
+    if ( ac <= _first )
+    {
+        std::cerr << "Reading from STDIN\n";
+        std::string     _line;
+        while ( std::getline( std::cin, _line ) )
+        {
+            _process( _line.c_str(), std::cout );
+        }
+    }
+    else
+    for ( int _ndx{_first}; _ndx < ac; ++_ndx )
+    {
+        _process( av[_ndx], std::cout );
+    }
+    std::cout.flush();
+
+    return 0;
+}
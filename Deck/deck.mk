@@ -1,33 +1,67 @@
 
 
-PROGRAMS := SeeDeal SeeFmt ToHex ToPbn ToLin
+PROGRAMS := SeeDeal SeeFmt ToHex ToPbn ToLin ToRank ToArc ToFmt GenDeals DDSolve DealStats DealIdx PlayOut LinRead SDSolve DealFind
 
-VPATH = ../Deck
+VPATH = ../Deck ../Utility
 
 CXX = g++
 CXXFLAGS = -pthread -m64 -std=c++14 -Wall
 
 # Need to set this in the environment
 INCLUDES = -I ../Utility
+DECKOBJS = Deck.o Deal.o Codec.o Bitboard.o DealWriter.o
 
 .cpp.o:
 	$(CXX) $(CXXFLAGS) $(INCLUDES) -c $< -o $@
 
 all: $(PROGRAMS)
 
-SeeDeal: SeeDeal.o Deck.o Deal.o
+SeeDeal: SeeDeal.o $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
-SeeFmt: SeeFmt.o  Deck.o Deal.o
+SeeFmt: SeeFmt.o  $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
-ToHex: ToHex.o  Deck.o Deal.o
+ToHex: ToHex.o  $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
-ToPbn: ToPbn.o  Deck.o Deal.o
+ToPbn: ToPbn.o  $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
-ToLin: ToLin.o  Deck.o Deal.o
+ToLin: ToLin.o  $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+ToRank: ToRank.o  DealNumber.o Symmetry.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+ToArc: ToArc.o  DealArchive.o DealNumber.o StrFile.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+ToFmt: ToFmt.o  Converter.o StrFile.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+GenDeals: GenDeals.o  Generator.o Constraint.o DealIndex.o DealArchive.o DealNumber.o StrFile.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+DDSolve: DDSolve.o  Solver.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+SDSolve: SDSolve.o  Simulator.o Solver.o Generator.o Constraint.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+DealStats: DealStats.o  HandStats.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+DealIdx: DealIdx.o  DealIndex.o DealArchive.o DealNumber.o Generator.o StrFile.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+DealFind: DealFind.o  FeatureIndex.o Constraint.o Generator.o DealArchive.o DealNumber.o StrFile.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+PlayOut: PlayOut.o  PlayState.o $(DECKOBJS)
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+LinRead: LinRead.o  LinFile.o PlayState.o StrFile.o $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
 clean:
@@ -6,122 +6,137 @@
 
 #include "Contract.h"
 
-#include <regex>
-#include <unordered_map>
 #include <array>
+#include <cstring>
 
 namespace bridge
 {
 namespace
 {
-    inline
+    // the scoring rules, evaluated once at compile time into scoreTable below
+    constexpr
     int as_integer( Contract::Level level )
     {
-        switch ( level )
-        {
-        default:
-        case Contract::Level::L1 : return 1;
-        case Contract::Level::L2 : return 2;
-        case Contract::Level::L3 : return 3;
-        case Contract::Level::L4 : return 4;
-        case Contract::Level::L5 : return 5;
-        case Contract::Level::L6 : return 6;
-        case Contract::Level::L7 : return 7;
-        }
+        return level == Contract::Level::L0 ? 1 : static_cast<int>(level);
     }
 
-    inline
+    constexpr
     int slam( Contract::Level level, bool vul )
     {
-        switch ( level )
-        {
-        case Contract::Level::L7 : return vul ? 1500 : 1000;
-        case Contract::Level::L6 : return vul ?  750 :  500;
-        default: return 0;
-        }
+        return level == Contract::Level::L7 ? (vul ? 1500 : 1000)
+             : level == Contract::Level::L6 ? (vul ?  750 :  500)
+             : 0;
     }
-}
 
-    int
-    Contract::score( int tricks ) const
+    //!> undertricks
+    constexpr
+    int minus( Contract::Dbld dbld, bool vul, int ut )
     {
-        if ( level_ == Level::L0 || tricks < 0 || tricks > 13 ) { return 0; }
-        int _diff(tricks - 6 - as_integer( level_ ));
-        return _diff < 0 ? -minus_( -_diff ) : plus_( _diff );
+        return dbld == Contract::Dbld::NO  ? ut * (vul ? 100 : 50)
+             : dbld == Contract::Dbld::YES ? (vul ? 200 + (ut - 1) * 300 : 100 + (ut - 1) * 200 + (ut > 3 ? ut - 3 : 0) * 100)
+             : (vul ? 400 + (ut - 1) * 600 : 200 + (ut - 1) * 400 + (ut > 3 ? ut - 3 : 0) * 200);
     }
 
-    int
-    Contract::minus_( int ut ) const
+    constexpr
+    int trickscore( Contract::Rank rank, int tricks )
     {
-        switch ( dbld_ )
-        {
-        case Dbld::NO   :
-            return ut * (vul_ ? 100 : 50);
-        case Dbld::YES  :
-            return vul_ ? 200 + (ut - 1) * 300 : 100 + (ut - 1) * 200 + (ut > 3 ? ut - 3 : 0) * 100;
-        case Dbld::AGAIN:
-            return vul_ ? 400 + (ut - 1) * 600 : 200 + (ut - 1) * 400 + (ut > 3 ? ut - 3 : 0) * 200;
-        default: return 0;
-        }
+        return rank == Contract::Rank::NT ? 40 + 30 * (tricks - 1)
+             : rank == Contract::Rank::MN ? 20 * tricks
+             : 30 * tricks;
     }
 
-    int
-    Contract::trickscore_( int tricks ) const
+    constexpr
+    int overtricks( Contract::Rank rank, Contract::Dbld dbld, bool vul, int ot )
     {
-        switch ( rank_ )
-        {
-        case Rank::NT : return 40 + 30 * (tricks - 1);
-        case Rank::MN : return 20 * tricks;
-        case Rank::MJ : return 30 * tricks;
-        default       : return 0;
-        }
+        return dbld == Contract::Dbld::NO  ? ot * (rank == Contract::Rank::MN ? 20 : 30)
+             : dbld == Contract::Dbld::YES ? ot * (vul ? 200 : 100)
+             : ot * (vul ? 400 : 200);
     }
-    
-    int
-    Contract::overtricks_( int ot ) const
+
+    //!> made, with 'ot' overtricks
+    constexpr
+    int plus( Contract::Level level, Contract::Rank rank, Contract::Dbld dbld, bool vul, int ot )
     {
-        switch ( dbld_ )
-        {
-        case Dbld::NO   :
-            switch ( rank_ )
-            {
-            case Rank::NT :
-            case Rank::MJ : return 30 * ot;
-            case Rank::MN : return 20 * ot;
-            }
-        case Dbld::YES  : return ot * (vul_ ? 200 : 100);
-        case Dbld::AGAIN: return ot * (vul_ ? 400 : 200);
-        default         : return 0;
-        }
+        int const   _ts{(dbld == Contract::Dbld::NO ? 1 : dbld == Contract::Dbld::YES ? 2 : 4) * trickscore( rank, as_integer( level ) )};
+        int const   _xtra{dbld == Contract::Dbld::NO ? 0 : dbld == Contract::Dbld::YES ? 50 : 100};
+        int const   _game{_ts < 100 ? 50 : vul ? 500 : 300};
+        return _ts + _xtra + overtricks( rank, dbld, vul, ot ) + _game + slam( level, vul );
+    }
+
+    constexpr
+    int rule_score( Contract::Level level, Contract::Rank rank, Contract::Dbld dbld, bool vul, int tricks )
+    {
+        return level == Contract::Level::L0 ? 0
+             : tricks < 6 + as_integer( level ) ? -minus( dbld, vul, 6 + as_integer( level ) - tricks )
+             : plus( level, rank, dbld, vul, tricks - 6 - as_integer( level ) );
+    }
+
+    //!> [level][rank][dbld][vul][tricks], level 0 all zero
+    struct ScoreTable
+    {
+        short   cell[8][3][3][2][14];
+    };
+
+    constexpr
+    ScoreTable make_scores()
+    {
+        ScoreTable  _table{};
+        for ( int _level{1}; _level <= 7; ++_level )
+            for ( int _rank{0}; _rank < 3; ++_rank )
+                for ( int _dbld{0}; _dbld < 3; ++_dbld )
+                    for ( int _vul{0}; _vul < 2; ++_vul )
+                        for ( int _tricks{0}; _tricks <= 13; ++_tricks )
+                        {
+                            _table.cell[_level][_rank][_dbld][_vul][_tricks] = static_cast<short>(rule_score(
+                                static_cast<Contract::Level>(_level), static_cast<Contract::Rank>(_rank),
+                                static_cast<Contract::Dbld>(_dbld), _vul != 0, _tricks ));
+                        }
+        return _table;
+    }
+
+    constexpr ScoreTable    scoreTable = make_scores();
+
+    constexpr
+    int lookup( int level, int rank, int dbld, int vul, int tricks )
+    {
+        return scoreTable.cell[level][rank][dbld][vul][tricks];
     }
-    
+
+    // spot checks of the table against the Laws
+    static_assert( lookup( 2, 0, 2, 1, 10 ) == 1680, "2NTXX vulnerable +2" );
+    static_assert( lookup( 4, 2, 0, 0, 10 ) == 420, "4H =" );
+    static_assert( lookup( 3, 0, 0, 1, 10 ) == 630, "3NT vulnerable +1" );
+    static_assert( lookup( 1, 1, 1, 0, 7 ) == 140, "1CX =" );
+    static_assert( lookup( 7, 0, 0, 1, 13 ) == 2220, "7NT vulnerable =" );
+    static_assert( lookup( 6, 1, 0, 0, 12 ) == 920, "6D =" );
+    static_assert( lookup( 4, 2, 1, 0, 6 ) == -800, "4HX -4 not vulnerable" );
+    static_assert( lookup( 7, 0, 2, 1, 0 ) == -7600, "7NTXX -13 vulnerable" );
+    static_assert( lookup( 3, 1, 0, 0, 8 ) == -50, "3C -1" );
+}
+
     int
-    Contract::plus_( int ot ) const
+    Contract::score( int tricks ) const
+    {
+        if ( tricks < 0 || tricks > 13 ) { return 0; }
+        return lookup( static_cast<int>(level_), static_cast<int>(rank_), static_cast<int>(dbld_), vul_, tricks );
+    }
+
+    /* static */ int
+    Contract::score( Level level, Rank rank, Dbld dbld, bool vul, int tricks )
     {
-        // trickscore
-        int _ts;
-        int _xtra;
-        switch ( dbld_ )
+        if ( tricks < 0 || tricks > 13 ) { return 0; }
+        return lookup( static_cast<int>(level), static_cast<int>(rank), static_cast<int>(dbld), vul, tricks );
+    }
+
+    /* static */ void
+    Contract::score_batch( std::size_t count, std::uint8_t const* level, std::uint8_t const* rank,
+                           std::uint8_t const* dbld, std::uint8_t const* vul, std::uint8_t const* tricks, int* out )
+    {
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
         {
-        case Dbld::NO   : 
-            _ts = trickscore_( as_integer( level_ ) );
-            _xtra = 0;
-            break;
-        case Dbld::YES  :
-            _ts = 2 * trickscore_( as_integer( level_ ) );
-            _xtra = 50;
-            break;
-        case Dbld::AGAIN:
-            _ts = 4 * trickscore_( as_integer( level_ ) );
-            _xtra = 100;
-            break;
+            out[_ndx] = tricks[_ndx] > 13 || level[_ndx] > 7 || rank[_ndx] > 2 || dbld[_ndx] > 2 ? 0
+                      : lookup( level[_ndx], rank[_ndx], dbld[_ndx], vul[_ndx] != 0, tricks[_ndx] );
         }
-        // overtricks
-        int _otb = overtricks_( ot );
-        // bonuses
-        int _game = (_ts < 100 ? 50 : vul_ ? 500 : 300);
-        // total
-        return _ts + _xtra + _otb + _game + slam( level_, vul_ );
     }
 
 #define GOAL(B)  (7 + (B - 1) / 5)
@@ -170,33 +185,6 @@ namespace
 
 namespace
 {
-    std::regex      contractPattern("^([1-7])([CDHNScdhns])([xX]([xX])?)?$");
-
-    std::unordered_map<std::string, Contract::Level> levelMap =
-    {
-        { "1", Contract::Level::L1 },
-        { "2", Contract::Level::L2 },
-        { "3", Contract::Level::L3 },
-        { "4", Contract::Level::L4 },
-        { "5", Contract::Level::L5 },
-        { "6", Contract::Level::L6 },
-        { "7", Contract::Level::L7 }
-    };
-
-    std::unordered_map<std::string, Contract::Rank> rankMap =
-    {
-        { "C", Contract::Rank::MN },
-        { "D", Contract::Rank::MN },
-        { "H", Contract::Rank::MJ },
-        { "N", Contract::Rank::NT },
-        { "S", Contract::Rank::MJ },
-        { "c", Contract::Rank::MN },
-        { "d", Contract::Rank::MN },
-        { "h", Contract::Rank::MJ },
-        { "n", Contract::Rank::NT },
-        { "s", Contract::Rank::MJ },
-    };
-
     std::array<std::array<bool, 2>, 4> sidevul =
     {{
         {{ false, false }},
@@ -222,27 +210,70 @@ namespace
         return sidevul[spec - 1][side % 2];
     }
 
+    /* static */ bool
+    Contract::parse( char const* spec, std::size_t len, Contract& out, char const** what )
+    {
+        auto        _fail([what]( char const* why ) { if ( what ) { *what = why; } return false; });
+        char const* _ptr{spec};
+        char const* _end{spec + len};
+        if ( _ptr == _end || *_ptr < '1' || *_ptr > '7' ) { return _fail( "level not 1..7" ); }
+        Level const _level{static_cast<Level>(*_ptr++ - '0')};
+        Rank        _rank;
+        switch ( _ptr < _end ? *_ptr++ | 0x20 : 0 )
+        {
+        case 's': case 'h': _rank = Rank::MJ; break;
+        case 'd': case 'c': _rank = Rank::MN; break;
+        case 'n':
+            _rank = Rank::NT;
+            if ( _ptr < _end && (*_ptr | 0x20) == 't' ) { ++_ptr; }
+            break;
+        default: return _fail( "strain not S, H, D, C or N" );
+        }
+        int _dbld{0};
+        for ( ; _ptr < _end && (*_ptr | 0x20) == 'x' && _dbld < 2; ++_ptr ) { ++_dbld; }
+        if ( _ptr != _end ) { return _fail( "extra characters" ); }
+        out.level( _level ).rank( _rank ).dbld( static_cast<Dbld>(_dbld) );
+        return true;
+    }
+
+    /* static */ std::size_t
+    Contract::parse_batch( std::size_t count, char const* const* specs, std::size_t const* lens, Contract* out, bool* ok,
+                           char const** what )
+    {
+        std::size_t _good{0};
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            if ( what ) { what[_ndx] = nullptr; }
+            _good += (ok[_ndx] = parse( specs[_ndx], lens[_ndx], out[_ndx], what ? what + _ndx : nullptr ));
+        }
+        return _good;
+    }
+
+    /* static */ char*
+    Contract::store_summary( char* buf, std::size_t len, char const* spec, std::size_t slen, int by, int tricks )
+    {
+        bool const  _known{slen > 0 && spec[0] > '0' && spec[0] < '8' && tricks >= 0 && tricks <= 13};
+        char const* _result{_known ? outcome[tricks + 6 - (spec[0] - '1')] : "?"};
+        std::size_t const   _rlen{std::strlen( _result )};
+        if ( len < slen + 1 + _rlen + 1 ) { return buf; }
+        std::memcpy( buf, spec, slen );
+        buf[slen] = " WNES"[by >= 1 && by <= 4 ? by : 0];
+        std::memcpy( buf + slen + 1, _result, _rlen + 1 );
+        return buf + slen + 1 + _rlen;
+    }
+
     std::string
     Contract::summary( std::string const& spec, int by, int tricks )
     {
-        auto    _isl([]( char const& l){ return l > '0' && l < '8'; });
-        return spec + " WNES"[by] + (_isl( spec[0] ) ? outcome[tricks + 6 - (spec[0] - '1')] : "?");
+        std::string _out(spec.size() + 5, '\0');
+        _out.resize( store_summary( &_out[0], _out.size(), spec.data(), spec.size(), by, tricks ) - &_out[0] );
+        return _out;
     }
 
     Contract::Contract(std::string const& spec)
     : Contract()
     {
-        std::cmatch     _m;
-        if ( std::regex_match( spec.c_str(), _m, contractPattern ) )
-        {
-            level_ = levelMap[_m.str( 1 )];
-            rank_  = rankMap[_m.str( 2 )];
-            dbld_  = _m.length( 4 ) > 0
-                   ? Contract::Dbld::AGAIN
-                   : _m.length( 3 ) > 0
-                   ? Contract::Dbld::YES
-                   : Contract::Dbld::NO;
-        }
+        parse( spec.data(), spec.size(), *this );
     }
 
 } // namespace bridge
@@ -8,6 +8,8 @@
 #ifndef BRIDGE_CONTRACT_H
 #define BRIDGE_CONTRACT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace bridge
@@ -17,6 +19,8 @@ namespace bridge
      * @brief Captures specification of a bid in Contract Bridge.
      * Enum classes are used to enforce valid values only.
      * Level is the only enum class needing numeric equivalents.
+     * Scores are read from a table over level, rank, doubling,
+     * vulnerability and tricks, computed at compile time.
      */
     class Contract
     {
@@ -54,10 +58,17 @@ namespace bridge
         {}
 
         explicit
-        Contract(std::string const&); // parse from string
+        Contract(std::string const&); // parse from string, the default if not a contract
 
         // Any number outside [0,13] returns 0
         int score( int tricks ) const;
+        static int score( Level, Rank, Dbld, bool vul, int tricks );
+        /**
+         * Columns of contracts: level 0..7 (0 passed out), rank and dbld as
+         * the enum values, vul 0 or 1, tricks 0..13. Scores go in out[].
+         */
+        static void score_batch( std::size_t count, std::uint8_t const* level, std::uint8_t const* rank,
+                                 std::uint8_t const* dbld, std::uint8_t const* vul, std::uint8_t const* tricks, int* out );
 
         Contract& level( Level l ) { level_ = l; return *this; }
         Contract& rank( Rank r )   { rank_  = r; return *this; }
@@ -74,6 +85,18 @@ namespace bridge
         static Rank  get_rank( int bid );
         static Dbld  get_dbld( int dbld );
         static bool  is_vul( int spec, int side );
+
+        /**
+         * "4S", "3NT", "6hx", "2NXX" into level, rank and dbld; vul is left
+         * as is. On failure 'out' is unchanged and 'what' says why.
+         */
+        static bool parse( char const* spec, std::size_t len, Contract& out, char const** what = nullptr );
+        //!> ok[i] for specs[i], and why not in what[i] (if given); returns how many parsed
+        static std::size_t parse_batch( std::size_t count, char const* const* specs, std::size_t const* lens,
+                                        Contract* out, bool* ok, char const** what = nullptr );
+
+        //!> spec, declarer and result, e.g. "4SXN-2" ('?' for an unknown result); buf unchanged if too small
+        static char* store_summary( char* buf, std::size_t len, char const* spec, std::size_t slen, int by, int tricks );
         static std::string summary( std::string const& spec, int by, int tricks );
 
     private:
@@ -81,11 +104,6 @@ namespace bridge
         Rank    rank_;
         Dbld    dbld_;
         bool    vul_;
-        //
-        int minus_( int ut ) const; // undertricks
-        int plus_( int ot = 0 ) const;  // overtricks
-        int trickscore_( int ) const;
-        int overtricks_( int ) const;
     };
 
 } // namespace bridge
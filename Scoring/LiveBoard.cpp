@@ -0,0 +1,91 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "LiveBoard.h"
+
+#include <algorithm>
+
+namespace bridge
+{
+    LiveBoard::LiveBoard(int lo, int hi, int step)
+    : lo_(lo)
+    , step_(std::max( step, 1 ))
+    , tree_((std::max( hi, lo ) - lo) / step_ + 2, 0)
+    , count_(tree_.size() - 1, 0)
+    {}
+
+    int
+    LiveBoard::bucket_( int score ) const
+    {
+        if ( score < lo_ || (score - lo_) % step_ != 0 ) { return -1; }
+        std::size_t const   _bucket{static_cast<std::size_t>((score - lo_) / step_)};
+        return _bucket < count_.size() ? static_cast<int>(_bucket) : -1;
+    }
+
+    void
+    LiveBoard::add_( int bucket, int delta )
+    {
+        count_[bucket] += delta;
+        for ( std::size_t _ndx{static_cast<std::size_t>(bucket) + 1}; _ndx < tree_.size(); _ndx += _ndx & (0 - _ndx) )
+        {
+            tree_[_ndx] += delta;
+        }
+    }
+
+    // results in buckets before 'bucket'
+    int
+    LiveBoard::below_( int bucket ) const
+    {
+        int _sum{0};
+        for ( std::size_t _ndx{static_cast<std::size_t>(bucket)}; _ndx > 0; _ndx &= _ndx - 1 ) { _sum += tree_[_ndx]; }
+        return _sum;
+    }
+
+    bool
+    LiveBoard::set( int pair, int score )
+    {
+        int const   _bucket{bucket_( score )};
+        if ( _bucket < 0 ) { return false; }
+        auto const  _found(scores_.find( pair ));
+        if ( _found != scores_.end() )
+        {
+            if ( _found->second == _bucket ) { return true; }
+            add_( _found->second, -1 );
+            _found->second = _bucket;
+        }
+        else { scores_.emplace( pair, _bucket ); }
+        add_( _bucket, 1 );
+        return true;
+    }
+
+    bool
+    LiveBoard::erase( int pair )
+    {
+        auto const  _found(scores_.find( pair ));
+        if ( _found == scores_.end() ) { return false; }
+        add_( _found->second, -1 );
+        scores_.erase( _found );
+        return true;
+    }
+
+    void
+    LiveBoard::clear()
+    {
+        std::fill( tree_.begin(), tree_.end(), 0 );
+        std::fill( count_.begin(), count_.end(), 0 );
+        scores_.clear();
+    }
+
+    int
+    LiveBoard::matchpoints( int pair ) const
+    {
+        auto const  _found(scores_.find( pair ));
+        if ( _found == scores_.end() ) { return -1; }
+        if ( scores_.size() == 1 ) { return 1; }
+        return 2 * below_( _found->second ) + count_[_found->second] - 1;
+    }
+
+} // namespace bridge
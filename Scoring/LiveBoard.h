@@ -0,0 +1,64 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_LIVEBOARD_H
+#define BRIDGE_LIVEBOARD_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace bridge
+{
+    /**
+     * @class LiveBoard
+     * @brief Matchpoints of one board kept up to date as results come in.
+     * Scores fall in buckets lo, lo + step, ... hi (by default every bridge
+     * score); a Fenwick tree over the bucket counts gives the number of
+     * results below any score, so entering, withdrawing or correcting a
+     * pair's result and asking for a pair's matchpoints are O(log k) in the
+     * k buckets, against rerunning mpt_score over the field each time.
+     *
+     * A pair's matchpoints are 2 for each result below its own and 1 for
+     * each other equal one, out of top() = 2 * (size() - 1), as mpt_score
+     * awards them; a lone result gets 1 of 2.
+     */
+    class LiveBoard
+    {
+    public:
+        ~LiveBoard() noexcept = default;
+        explicit
+        LiveBoard(int lo = -7600, int hi = 7600, int step = 10);
+
+        //!> enters or corrects a pair's score; false if not on the bucket grid
+        bool set( int pair, int score );
+        //!> false if the pair has no result
+        bool erase( int pair );
+        void clear();
+
+        std::size_t size() const { return scores_.size(); }
+        int top() const { return size() > 1 ? 2 * (static_cast<int>(size()) - 1) : 2; }
+        bool has( int pair ) const { return scores_.count( pair ) != 0; }
+
+        //!> the pair's matchpoints out of top(); -1 if the pair has no result
+        int matchpoints( int pair ) const;
+
+    private:
+        int                             lo_;
+        int                             step_;
+        std::vector<int>                tree_;      //!< Fenwick, 1-based
+        std::vector<int>                count_;     //!< per bucket
+        std::unordered_map<int, int>    scores_;    //!< pair to bucket
+
+        int bucket_( int score ) const;
+        void add_( int bucket, int delta );
+        int below_( int bucket ) const;
+    };
+
+} // namespace bridge
+
+#endif // BRIDGE_LIVEBOARD_H
@@ -0,0 +1,195 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Par.h"
+#include "Contract.h"
+
+#include <algorithm>
+
+namespace bridge
+{
+namespace
+{
+    enum { NONE = 1 << 20 }; // worse than any score
+
+    char const  strains[] = "SHDCN";
+    int const   denom[] = {3, 2, 1, 0, 4}; // bid order C D H S N to strain
+
+    Contract::Rank as_rank( int strain )
+    {
+        return strain == 4 ? Contract::Rank::NT : strain < 2 ? Contract::Rank::MJ : Contract::Rank::MN;
+    }
+
+    /**
+     * Declarer's score for [vul][strain][level - 1][tricks]: undoubled if
+     * the contract makes, doubled if not.
+     */
+    struct Scores
+    {
+        std::array<std::array<std::array<std::array<int, 14>, 7>, 5>, 2>   cell;
+
+        Scores()
+        {
+            for ( int _vul{0}; _vul < 2; ++_vul )
+            {
+                for ( int _strain{0}; _strain < 5; ++_strain )
+                {
+                    for ( int _level{1}; _level <= 7; ++_level )
+                    {
+                        for ( int _tricks{0}; _tricks <= 13; ++_tricks )
+                        {
+                            Contract const  _contract(static_cast<Contract::Level>(_level), as_rank( _strain ),
+                                                      _tricks < _level + 6 ? Contract::Dbld::YES : Contract::Dbld::NO,
+                                                      _vul != 0);
+                            cell[_vul][_strain][_level - 1][_tricks] = _contract.score( _tricks );
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Scores const& scores()
+    {
+        static Scores const _scores;
+        return _scores;
+    }
+
+    //!> North-South (0) take the larger, East-West (1) the smaller
+    inline
+    int better( int side, int a, int b )
+    {
+        return side == 0 ? std::max( a, b ) : std::min( a, b );
+    }
+}
+
+    /**
+     * Backward over the 35 bids. After a bid by side d the other side t,
+     * then d, then t may bid higher or pass; three passes end it.
+     */
+    Par::Result& /* static */
+    Par::compute( Table const& table, int dealer, int vul, Result& out )
+    {
+        out = Result();
+        for ( auto const& _row : table )
+        {
+            for ( int _tricks : _row ) { if ( _tricks < 0 || _tricks > 13 ) { out.count = -1; return out; } }
+        }
+
+        auto const& _cell(scores().cell);
+        int         _tricks[2][5];  // best for each side (NS EW) and strain
+        int         _seats[2][5];
+        bool const  _vul[2] = { Contract::is_vul( vul, 2 ), Contract::is_vul( vul, 1 ) };
+        for ( int _strain{0}; _strain < 5; ++_strain )
+        {
+            for ( int _side{0}; _side < 2; ++_side )
+            {
+                int const   _first{table[_strain][_side == 0 ? 1 : 0]}; // N or W
+                int const   _second{table[_strain][_side == 0 ? 3 : 2]}; // S or E
+                _tricks[_side][_strain] = std::max( _first, _second );
+                _seats[_side][_strain] = (_first == _tricks[_side][_strain] ? 1 << (_side == 0 ? 2 : 1) : 0)
+                                       | (_second == _tricks[_side][_strain] ? 1 << (_side == 0 ? 4 : 3) : 0);
+            }
+        }
+        auto        _value([&]( int bid, int side ) -> int
+        {
+            int const   _strain{denom[bid % 5]};
+            int const   _score{_cell[_vul[side]][_strain][bid / 5][_tricks[side][_strain]]};
+            return side == 0 ? _score : -_score;
+        });
+
+        // best each side can get by bidding higher, at each bid: none at first
+        std::array<std::array<int, 2>, 36>  _above;
+        _above[35] = {{-NONE, NONE}};
+        for ( int _bid{34}; _bid >= 0; --_bid )
+        {
+            _above[_bid] = _above[_bid + 1];
+            for ( int _side{0}; _side < 2; ++_side )
+            {
+                std::array<int, 2> const&   _over(_above[_bid + 1]);
+                int const                   _other{1 - _side};
+                int const                   _best{better( _other, better( _side, better( _other, _value( _bid, _side ), _over[_other] ), _over[_side] ), _over[_other] )};
+                _above[_bid][_side] = better( _side, _above[_bid][_side], _best );
+            }
+        }
+        // four passes from the dealer pass it out
+        int const   _first{dealer % 2 == 0 ? 0 : 1};
+        int         _par{0};
+        for ( int _pass{3}; _pass >= 0; --_pass )
+        {
+            int const   _side{_pass % 2 == 0 ? _first : 1 - _first};
+            _par = better( _side, _par, _above[0][_side] );
+        }
+
+        // the lowest contracts reaching par that the other side cannot
+        // overcall without losing
+        out.score = _par;
+        for ( int _side{0}; _par != 0 && _side < 2; ++_side )
+        {
+            for ( int _strain{0}; _strain < 5; ++_strain )
+            {
+                for ( int _level{1}; _level <= 7; ++_level )
+                {
+                    int const   _bid{5 * (_level - 1) + static_cast<int>(std::find( denom, denom + 5, _strain ) - denom)};
+                    int const   _over{_above[_bid + 1][1 - _side]};
+                    if ( _value( _bid, _side ) == _par && better( 1 - _side, _par, _over ) == _par && _over != _par )
+                    {
+                        int const   _took{_tricks[_side][_strain]};
+                        out.bids[out.count++] = Bid{_level, _strain, _seats[_side][_strain], _took, _took < _level + 6};
+                        break;
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    void /* static */
+    Par::compute( Table const* tables, std::size_t count, int first, Result* out )
+    {
+        for ( std::size_t _ndx{0}; _ndx < count; ++_ndx )
+        {
+            int const   _board{first + static_cast<int>(_ndx)};
+            compute( tables[_ndx], dealer( _board ), vul( _board ), out[_ndx] );
+        }
+    }
+
+    // board 1: North
+    int /* static */
+    Par::dealer( int board )
+    {
+        return (board % 4 + 4) % 4 + 1;
+    }
+
+    // the usual cycle of 16
+    int /* static */
+    Par::vul( int board )
+    {
+        static int const    _cycle[16] = {1, 2, 3, 4, 2, 3, 4, 1, 3, 4, 1, 2, 4, 1, 2, 3};
+        return _cycle[((board - 1) % 16 + 16) % 16];
+    }
+
+    std::string /* static */
+    Par::summary( Result const& result )
+    {
+        if ( result.count <= 0 ) { return result.count < 0 ? "?" : "pass"; }
+        std::string     _out;
+        for ( int _ndx{0}; _ndx < result.count; ++_ndx )
+        {
+            Bid const&      _bid(result.bids[_ndx]);
+            char const      _spec[]{char('0' + _bid.level), strains[_bid.strain], 'X'};
+            char            _buf[16];
+            for ( int _seat{1}; _seat <= 4; ++_seat )
+            {
+                if ( !(_bid.seats & 1 << _seat) ) { continue; }
+                if ( !_out.empty() ) { _out.push_back( ' ' ); }
+                _out.append( _buf, Contract::store_summary( _buf, sizeof _buf, _spec, _bid.doubled ? 3 : 2, _seat, _bid.tricks ) );
+            }
+        }
+        return _out;
+    }
+
+} // namespace bridge
@@ -0,0 +1,63 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_PAR_H
+#define BRIDGE_PAR_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace bridge
+{
+    /**
+     * @class Par
+     * @brief Par score and contracts from a double dummy trick table.
+     * The table is indexed [strain][seat - 1] with strains S H D C N and
+     * seats WNES 1..4, as from DDSolver. Dealer is a seat; vulnerability is
+     * the spec of Contract::is_vul (1 none, 2 NS, 3 EW, 4 both).
+     *
+     * Par is the result of an auction with all hands in view: each side
+     * bids in turn from the dealer, contracts that make are played
+     * undoubled, those that fail are doubled, and a side may declare a
+     * strain from the better placed hand. Scores are looked up in a table
+     * built once from Contract::score.
+     */
+    class Par
+    {
+    public:
+        using Table = std::array<std::array<int, 4>, 5>;
+
+        struct Bid
+        {
+            int     level;      //!< 1..7
+            int     strain;     //!< S H D C N 0..4
+            int     seats;      //!< declarers, bit (1 << seat)
+            int     tricks;     //!< taken by declarer
+            bool    doubled;
+        };
+        struct Result
+        {
+            int                     score{0};   //!< for North-South
+            int                     count{0};   //!< 0 when passed out
+            std::array<Bid, 10>     bids;       //!< lowest level per side and strain
+        };
+
+        static Result& compute( Table const&, int dealer, int vul, Result& );
+        //!> tables for boards first, first + 1, ... with dealer and vulnerability by board
+        static void compute( Table const* tables, std::size_t count, int first, Result* out );
+
+        static int dealer( int board );
+        static int vul( int board );
+
+        //!> e.g. "4SN= 4SS=" or "5HXE-1", "pass" if passed out
+        static std::string summary( Result const& );
+    };
+
+} // namespace bridge
+
+#endif // BRIDGE_PAR_H
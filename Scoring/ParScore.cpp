@@ -0,0 +1,148 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "Par.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+using namespace bridge;
+
+    /**
+     * ParScore: par for each line of DDSolve output,
+     *   <deal>  8855 9944 4499 5588 7766
+     * that is, a group per strain (S H D C N) of one hex digit per declarer
+     * (N S E W). Lines are boards first, first + 1, ... for dealer and
+     * vulnerability. Each output line is the deal, the board, the par score
+     * for North-South and the par contracts.
+     *   ParScore [-f first] [-b] [file]
+     * -b times the calculation instead.
+     */
+
+namespace
+{
+    int const   order[] = {2, 4, 3, 1}; // N S E W
+
+    int digit( char c )
+    {
+        return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'd' ? c - 'a' + 10 : c >= 'A' && c <= 'D' ? c - 'A' + 10 : -1;
+    }
+
+    //!> the deal and its table from a line
+    bool parse( std::string const& line, std::string& deal, Par::Table& table )
+    {
+        std::istringstream          _in(line);
+        std::vector<std::string>    _words;
+        for ( std::string _word; _in >> _word; ) { _words.push_back( _word ); }
+        if ( _words.size() < 5 ) { return false; }
+        deal = _words.size() > 5 ? _words[_words.size() - 6] : "-";
+        for ( int _strain{0}; _strain < 5; ++_strain )
+        {
+            std::string const&  _group(_words[_words.size() - 5 + _strain]);
+            if ( _group.size() != 4 ) { return false; }
+            for ( int _ndx{0}; _ndx < 4; ++_ndx )
+            {
+                if ( (table[_strain][order[_ndx] - 1] = digit( _group[_ndx] )) < 0 ) { return false; }
+            }
+        }
+        return true;
+    }
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-f first] [-b] [file]\n";
+    return 2;
+}
+
+int benchmark( std::vector<Par::Table> const& tables, int first )
+{
+    using Clock = std::chrono::steady_clock;
+    std::size_t const           _rounds{tables.empty() ? 0 : (1000000 + tables.size() - 1) / tables.size()};
+    std::vector<Par::Result>    _results(tables.size());
+    long                        _sum{0};
+
+    auto const  _t0(Clock::now());
+    for ( std::size_t _round{0}; _round < _rounds; ++_round )
+    {
+        Par::compute( tables.data(), tables.size(), first, _results.data() );
+        for ( auto const& _result : _results ) { _sum += _result.score; }
+    }
+    double const _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    std::cout << "tables: " << _rounds * tables.size() << " seconds: " << _secs << "\n"
+              << "tables/sec: " << (_rounds * tables.size() / _secs)
+              << " checksum: " << _sum << std::endl;
+    return 0;
+}
+
+int main( int ac, char* av[] )
+{
+    int     _first{1};
+    bool    _bench{false};
+    int     _opt;
+
+    while ( (_opt = ::getopt( ac, av, "f:b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'f': _first = std::atoi( ::optarg ); break;
+        case 'b': _bench = true; break;
+        default: return usage( av[0] );
+        }
+    }
+
+    std::ifstream   _file;
+    if ( ::optind < ac )
+    {
+        _file.open( av[::optind] );
+        if ( !_file )
+        {
+            std::cerr << "Cannot open " << av[::optind] << ": " << ::strerror( errno ) << "\n";
+            return 1;
+        }
+    }
+    else { std::cerr << "Reading from STDIN\n"; }
+    std::istream&   _in(::optind < ac ? _file : std::cin);
+
+    std::vector<std::string>    _deals;
+    std::vector<Par::Table>     _tables;
+    std::size_t                 _errors{0};
+    std::string                 _line;
+    for ( std::size_t _lineno{1}; std::getline( _in, _line ); ++_lineno )
+    {
+        std::string     _deal;
+        Par::Table      _table;
+        if ( _line.find_first_not_of( " \t\r" ) == std::string::npos ) { continue; }
+        if ( !parse( _line, _deal, _table ) )
+        {
+            if ( _errors++ == 0 ) { std::cerr << "Bad table at line " << _lineno << "\n"; }
+            continue;
+        }
+        _deals.push_back( _deal );
+        _tables.push_back( _table );
+    }
+    if ( _bench ) { return benchmark( _tables, _first ); }
+
+    std::vector<Par::Result>    _results(_tables.size());
+    Par::compute( _tables.data(), _tables.size(), _first, _results.data() );
+    std::string     _out;
+    for ( std::size_t _ndx{0}; _ndx < _results.size(); ++_ndx )
+    {
+        _out.append( _deals[_ndx] ).append( "  " ).append( std::to_string( _first + _ndx ) )
+            .append( "  " ).append( std::to_string( _results[_ndx].score ) )
+            .append( "  " ).append( Par::summary( _results[_ndx] ) ).push_back( '\n' );
+    }
+    std::cout << _out << std::flush;
+    return _errors ? 1 : 0;
+}
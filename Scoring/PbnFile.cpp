@@ -0,0 +1,293 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "PbnFile.h"
+#include "StrFile.h"
+
+#include <algorithm>
+#include <ctype.h>
+
+namespace bridge
+{
+namespace
+{
+    inline
+    bool blank( char c ) { return c == ' ' || c == '\t'; }
+
+    inline
+    char const* skip( char const* ptr, char const* end )
+    {
+        while ( ptr < end && blank( *ptr ) ) { ++ptr; }
+        return ptr;
+    }
+
+    //!> WNES 1..4, 0 if not a seat
+    int to_seat( char c )
+    {
+        switch ( c )
+        {
+        case 'W': case 'w': return 1;
+        case 'N': case 'n': return 2;
+        case 'E': case 'e': return 3;
+        case 'S': case 's': return 4;
+        default: return 0;
+        }
+    }
+
+    bool same( PbnFile::Text const& text, char const* str )
+    {
+        std::size_t _ndx{0};
+        for ( ; _ndx < text.len && str[_ndx]; ++_ndx )
+        {
+            if ( (text.ptr[_ndx] | 0x20) != (str[_ndx] | 0x20) ) { return false; }
+        }
+        return _ndx == text.len && !str[_ndx];
+    }
+
+    //!> "4S", "3NT", "6HX", "2NTXX"; false if not a contract
+    bool to_contract( Contract& bid, PbnFile::Text const& text )
+    {
+        Contract    _bid;
+        if ( !Contract::parse( text.ptr, text.len, _bid ) ) { return false; }
+        bid = _bid;
+        return true;
+    }
+}
+
+    int
+    PbnFile::Game::score() const
+    {
+        if ( passed || by == 0 || tricks < 0 ) { return 0; }
+        int const   _score{bid.score( tricks )};
+        return by % 2 == 0 ? _score : -_score;
+    }
+
+    PbnFile::~PbnFile() noexcept = default;
+
+    PbnFile::PbnFile(char const* file)
+    : file_(new Utility::StrFile(file))
+    {
+        if ( !*file_ ) { err_ = file_->error(); return; }
+        pos_ = bol_ = file_->get();
+        size_ = file_->size();
+        end_  = pos_ + size_;
+    }
+
+    PbnFile::PbnFile(char const* buf, std::size_t len)
+    : pos_(buf)
+    , end_(buf + len)
+    , bol_(buf)
+    , size_(len)
+    {}
+
+    void
+    PbnFile::fail_( Game& game, char const* at, char const* what )
+    {
+        game.ok = false;
+        errors_.push_back( {line_, static_cast<std::size_t>(at - bol_) + 1, what} );
+    }
+
+    /**
+     * One tag at ptr ('['), moving ptr past it. The value is decoded at
+     * once, while its line and column are known. Returns false if the rest
+     * of the line is to be skipped.
+     */
+    bool
+    PbnFile::tag_( Game& game, char const*& ptr, char const* eol, Text*& section )
+    {
+        char const* _name{ptr = skip( ptr + 1, eol )};
+        while ( ptr < eol && (::isalnum( static_cast<unsigned char>(*ptr) ) || *ptr == '_') ) { ++ptr; }
+        Text const  _tag{_name, static_cast<std::size_t>(ptr - _name)};
+        ptr = skip( ptr, eol );
+        if ( _tag.empty() || ptr == eol || *ptr != '"' ) { fail_( game, ptr, "expected a tag name and value" ); return false; }
+
+        char const* _value{++ptr};
+        while ( ptr < eol && *ptr != '"' ) { ptr += (*ptr == '\\' && ptr + 1 < eol) ? 2 : 1; }
+        if ( ptr >= eol ) { fail_( game, _value - 1, "unterminated tag value" ); return false; }
+        Text        _text{_value, static_cast<std::size_t>(ptr - _value)};
+        ptr = skip( ptr + 1, eol );
+        if ( ptr == eol || *ptr != ']' ) { fail_( game, ptr, "expected ]" ); return false; }
+        ++ptr;
+
+        bool const  _repeat{_text.is( "#" )};
+        section = nullptr;
+        if ( _tag.is( "Event" ) ) { game.event = _repeat ? last_.event : _text; }
+        else if ( _tag.is( "Board" ) ) { game.board = _repeat ? last_.board : _text; }
+        else if ( _tag.is( "Dealer" ) )
+        {
+            if ( _repeat ) { game.dealer = last_.dealer; game.dlr = last_.dlr; return true; }
+            game.dealer = _text;
+            game.dlr    = _text.len == 1 ? to_seat( *_value ) : 0;
+            if ( !_text.empty() && !game.dlr ) { fail_( game, _value, "bad dealer" ); }
+        }
+        else if ( _tag.is( "Vulnerable" ) )
+        {
+            if ( _repeat ) { game.vulnerable = last_.vulnerable; game.vul = last_.vul; return true; }
+            game.vulnerable = _text;
+            if ( same( _text, "None" ) || same( _text, "Love" ) || _text.is( "-" ) || _text.empty() ) { game.vul = 1; }
+            else if ( same( _text, "NS" ) ) { game.vul = 2; }
+            else if ( same( _text, "EW" ) ) { game.vul = 3; }
+            else if ( same( _text, "All" ) || same( _text, "Both" ) ) { game.vul = 4; }
+            else { fail_( game, _value, "bad vulnerability" ); }
+        }
+        else if ( _tag.is( "Deal" ) )
+        {
+            if ( _repeat ) { game.deal = last_.deal; game.deck = last_.deck; game.dealt = last_.dealt; return true; }
+            // load_pbn_s reads to the end of the line, so the value goes through a stack buffer
+            char    _buf[96];
+            game.deal = _text;
+            if ( _text.len + 1 > sizeof _buf ) { fail_( game, _value, "bad deal" ); return true; }
+            std::copy( _value, _value + _text.len, _buf );
+            _buf[_text.len] = '\0';
+            game.deck = Deck();
+            game.dealt = _text.len > 2 && game.deck.load_pbn_s( _buf )
+                      && game.deck.count( 1 ) == 13 && game.deck.count( 2 ) == 13
+                      && game.deck.count( 3 ) == 13 && game.deck.count( 4 ) == 13;
+            if ( !game.dealt ) { fail_( game, _value, "bad deal" ); }
+        }
+        else if ( _tag.is( "Declarer" ) )
+        {
+            if ( _repeat ) { game.declarer = last_.declarer; game.by = last_.by; return true; }
+            game.declarer = _text;
+            char const* _seat{_text.len > 1 && *_value == '^' ? _value + 1 : _value};
+            if ( _text.empty() ) { game.by = 0; }
+            else if ( _seat + 1 != _value + _text.len || !(game.by = to_seat( *_seat )) ) { fail_( game, _value, "bad declarer" ); }
+        }
+        else if ( _tag.is( "Contract" ) )
+        {
+            if ( _repeat ) { _text = last_.contract; }
+            game.contract = _text;
+            game.passed   = same( _text, "Pass" );
+            if ( !game.passed && !_text.empty() && !to_contract( game.bid, _text ) ) { fail_( game, _value, "bad contract" ); }
+        }
+        else if ( _tag.is( "Result" ) )
+        {
+            if ( _repeat ) { game.result = last_.result; game.tricks = last_.tricks; return true; }
+            game.result = _text;
+            game.tricks = _text.empty() ? -1 : 0;
+            for ( std::size_t _ndx{0}; _ndx < _text.len; ++_ndx )
+            {
+                if ( _value[_ndx] < '0' || _value[_ndx] > '9' || (game.tricks = 10 * game.tricks + _value[_ndx] - '0') > 13 )
+                {
+                    fail_( game, _value, "bad result" );
+                    game.tricks = -1;
+                    break;
+                }
+            }
+        }
+        else if ( _tag.is( "Auction" ) ) { game.auction = Text(); section = &game.auction; }
+        else if ( _tag.is( "Play" ) ) { game.play = Text(); section = &game.play; }
+        return true;
+    }
+
+    void
+    PbnFile::decode_( Game& game )
+    {
+        if ( game.passed ) { game.by = 0; }
+        if ( game.by ) { game.bid.vul( Contract::is_vul( game.vul, game.by % 2 ) ); }
+        last_ = game;
+        ++games_;
+    }
+
+    /**
+     * Section text [from, to) on a line. It stays a span of the file while
+     * only blanks and line ends come between its pieces; once a comment
+     * comes between them it is copied into 'own', with a blank for each
+     * comment cut.
+     */
+    void
+    PbnFile::text_( Text& section, std::string& own, char const* from, char const* to )
+    {
+        if ( !section.ptr ) { own.clear(); section.ptr = from; }
+        else if ( cut_ || !own.empty() )
+        {
+            if ( own.empty() ) { own.assign( section.ptr, last_end_ ); }
+            if ( cut_ ) { own.push_back( ' ' ); }
+            else { own.append( last_end_, from ); }
+            own.append( from, to );
+            section.ptr = own.data();
+            section.len = own.size();
+            last_end_   = to;
+            cut_        = false;
+            return;
+        }
+        section.len = static_cast<std::size_t>(to - section.ptr);
+        last_end_   = to;
+        cut_        = false;
+    }
+
+    bool
+    PbnFile::next( Game& game )
+    {
+        game = Game();
+        Text*   _section{nullptr};
+        bool    _started{false};
+        cut_ = false;
+        while ( pos_ && pos_ < end_ )
+        {
+            char const* _eol{static_cast<char const*>(std::memchr( pos_, '\n', end_ - pos_ ))};
+            char const* _next{_eol ? _eol + 1 : end_};
+            if ( !_eol ) { _eol = end_; }
+            char const* _end{_eol > pos_ && _eol[-1] == '\r' ? _eol - 1 : _eol};
+            char const* _ptr{skip( pos_, _end )};
+
+            if ( _ptr == _end && pos_ == bol_ && _started )
+            {
+                pos_ = bol_ = _next;
+                ++line_;
+                decode_( game );
+                return true;
+            }
+            if ( _ptr < _end && *_ptr == '%' && pos_ == bol_ ) { cut_ = true; _ptr = _end; }
+
+            // tags, comments and section text, in any order along the line
+            bool    _over{false};   //!< a comment ran over lines
+            while ( _ptr < _end )
+            {
+                if ( *_ptr == ';' ) { cut_ = true; break; }
+                if ( *_ptr == '{' )
+                {
+                    char const* _close{static_cast<char const*>(std::memchr( _ptr, '}', end_ - _ptr ))};
+                    if ( !_close ) { fail_( game, _ptr, "unterminated comment" ); _close = end_; }
+                    for ( char const* _nl{_ptr}; (_nl = static_cast<char const*>(std::memchr( _nl, '\n', _close - _nl ))); bol_ = ++_nl )
+                    {
+                        ++line_;
+                        _over = true;
+                    }
+                    cut_ = true;
+                    pos_ = _close < end_ ? _close + 1 : end_;
+                    if ( _over ) { break; }
+                    _ptr = skip( pos_, _end );
+                    continue;
+                }
+                if ( *_ptr == '[' )
+                {
+                    if ( !_started ) { game.line = line_; }
+                    _started = true;
+                    if ( !tag_( game, _ptr, _end, _section ) ) { break; }
+                }
+                else if ( !_section ) { fail_( game, _ptr, "text outside a tag or section" ); break; }
+                else
+                {
+                    char const* _stop{_ptr};
+                    while ( _stop < _end && *_stop != '{' && *_stop != ';' ) { ++_stop; }
+                    char const* _last{_stop};
+                    while ( _last > _ptr && blank( _last[-1] ) ) { --_last; }
+                    text_( *_section, _section == &game.auction ? auction_ : play_, _ptr, _last );
+                    _ptr = _stop;
+                }
+                _ptr = skip( _ptr, _end );
+            }
+            if ( _over ) { continue; }
+            pos_ = bol_ = _next;
+            ++line_;
+        }
+        if ( !_started ) { return false; }
+        decode_( game );
+        return true;
+    }
+
+} // namespace bridge
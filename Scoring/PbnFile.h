@@ -0,0 +1,119 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+
+#ifndef BRIDGE_PBNFILE_H
+#define BRIDGE_PBNFILE_H
+
+#include "Contract.h"
+#include "Deck.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Utility { class StrFile; }
+
+namespace bridge
+{
+    /**
+     * @class PbnFile
+     * @brief The games of a PBN file, one at a time, read in place from the
+     * memory mapped file (or a NUL terminated buffer).
+     * Tag values and the auction and play sections are spans of the file,
+     * and the deal, contract and result are decoded from them directly, so
+     * a game costs no allocation. A value of "#" repeats the one of the
+     * game before, as in PBN export files. Comments ({...}, which may run
+     * over lines, and ;... to the end of the line) are skipped wherever
+     * they are, as are % lines. Auction or play text with a comment inside
+     * is the one thing copied: it is kept in the PbnFile, without the
+     * comments, until the next game is read.
+     *
+     * A game with a problem is still returned, with ok false; the problem
+     * goes into errors() with its line and column (from 1).
+     */
+    class PbnFile
+    {
+    public:
+        struct Text
+        {
+            char const* ptr{nullptr};
+            std::size_t len{0};
+
+            bool empty() const { return len == 0; }
+            bool is( char const* str ) const { return std::strlen( str ) == len && std::strncmp( ptr, str, len ) == 0; }
+        };
+
+        struct Error
+        {
+            std::size_t line;
+            std::size_t column;
+            char const* what;
+        };
+
+        struct Game
+        {
+            std::size_t line{0};        //!< of the first tag
+            Text        event, board, dealer, vulnerable, deal, declarer, contract, result;
+            Text        auction, play;  //!< the sections after the tags, as is
+            //
+            bool        ok{true};
+            bool        dealt{false};   //!< the Deal tag was a full deal
+            Deck        deck;
+            int         dlr{0};         //!< seat WNES 1..4, 0 if not given
+            int         vul{1};         //!< 1..4 none, NS, EW, both, as for Contract::is_vul
+            int         by{0};          //!< declarer seat, 0 if passed out or not given
+            int         tricks{-1};     //!< declarer's, -1 if not given
+            bool        passed{false};
+            Contract    bid;            //!< vulnerability set for the declaring side
+
+            //!> North-South score, 0 if passed out or the result is unknown
+            int score() const;
+        };
+
+        ~PbnFile() noexcept;
+        explicit
+        PbnFile(char const* file);
+        //!> buf[len] must be a NUL
+        PbnFile(char const* buf, std::size_t len);
+
+        explicit operator bool() const { return pos_ != nullptr; }
+        int error() const { return err_; } //!< errno, if the file did not open
+
+        //!> false at the end of the file
+        bool next( Game& );
+
+        std::vector<Error> const& errors() const { return errors_; }
+        std::size_t games() const { return games_; }
+        std::size_t size() const { return size_; }  //!< bytes in all
+
+    private:
+        std::unique_ptr<Utility::StrFile>   file_;
+        char const*         pos_{nullptr};
+        char const*         end_{nullptr};
+        char const*         bol_{nullptr};  //!< start of the current line
+        std::size_t         size_{0};
+        std::size_t         line_{1};
+        std::size_t         games_{0};
+        int                 err_{0};
+        Game                last_;          //!< tag values for "#"
+        std::vector<Error>  errors_;
+        std::string         auction_;       //!< section text with comments cut
+        std::string         play_;
+        char const*         last_end_{nullptr}; //!< of the section text so far
+        bool                cut_{false};    //!< a comment since then
+
+        void fail_( Game&, char const* at, char const* what );
+        bool tag_( Game&, char const*& ptr, char const* eol, Text*& section );
+        void text_( Text& section, std::string& own, char const* from, char const* to );
+        void decode_( Game& );
+    };
+
+} // namespace bridge
+
+#endif // BRIDGE_PBNFILE_H
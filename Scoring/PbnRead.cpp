@@ -0,0 +1,129 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+
+#include "PbnFile.h"
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+
+using namespace bridge;
+
+    /**
+     * PbnRead: games of a PBN file, one line each: board, hex deal,
+     * dealer, vulnerability, contract with declarer and result, and the
+     * North-South score.
+     *   PbnRead [-b] [file]
+     * Errors go to STDERR as file:line:column. -b only parses, and reports
+     * games and megabytes per second. With no file, STDIN is read into
+     * memory.
+     */
+
+namespace
+{
+    char const  seats[] = "-WNES";
+    char const* vuls[]  = { "?", "None", "NS", "EW", "All" };
+
+    std::ostream& operator<<( std::ostream& os, PbnFile::Text const& text )
+    {
+        return os.write( text.ptr, static_cast<std::streamsize>(text.len) );
+    }
+}
+
+int usage( char const* prog )
+{
+    std::cerr << "Usage: " << prog << " [-b] [file]\n";
+    return 2;
+}
+
+void show( std::ostream& os, PbnFile::Game const& game )
+{
+    char    _hex[32]{"-"};
+    if ( game.dealt ) { game.deck.store_hex( _hex ); }
+    os << (game.board.empty() ? PbnFile::Text{"-", 1} : game.board) << " " << _hex
+       << " " << seats[game.dlr] << " " << vuls[game.vul] << " ";
+    if ( game.passed ) { os << "Pass"; }
+    else if ( game.contract.empty() || !game.by ) { os << "-"; }
+    else
+    {
+        int const   _over{game.tricks - 6 - (game.contract.ptr[0] - '0')};
+        os << game.contract << seats[game.by];
+        if ( game.tricks < 0 ) { os << "?"; }
+        else if ( _over == 0 ) { os << "="; }
+        else { os << (_over > 0 ? "+" : "") << _over; }
+    }
+    os << " " << game.score() << (game.ok ? "" : " !") << "\n";
+}
+
+int main( int ac, char* av[] )
+{
+    bool    _bench{false};
+    int     _opt;
+
+    while ( (_opt = ::getopt( ac, av, "b" )) != -1 )
+    {
+        switch ( _opt )
+        {
+        case 'b': _bench = true; break;
+        default: return usage( av[0] );
+        }
+    }
+
+    std::string                 _input;
+    std::unique_ptr<PbnFile>    _pbn;
+    char const*                 _name{"-"};
+    if ( ::optind < ac )
+    {
+        _name = av[::optind];
+        _pbn.reset( new PbnFile(_name) );
+        if ( !*_pbn )
+        {
+            std::cerr << "Cannot open " << _name << ": " << ::strerror( _pbn->error() ) << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        std::cerr << "Reading from STDIN\n";
+        _input.assign( std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>() );
+        _pbn.reset( new PbnFile(_input.data(), _input.size()) );
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto const      _t0(Clock::now());
+    PbnFile::Game   _game;
+    std::size_t     _bad{0};
+    long long       _total{0};
+    while ( _pbn->next( _game ) )
+    {
+        _bad += !_game.ok;
+        if ( _bench )
+        {
+            _total += _game.score();
+            continue;
+        }
+        show( std::cout, _game );
+    }
+    double const    _secs{std::chrono::duration<double>(Clock::now() - _t0).count()};
+
+    for ( auto const& _error : _pbn->errors() )
+    {
+        std::cerr << _name << ":" << _error.line << ":" << _error.column << ": " << _error.what << "\n";
+    }
+    if ( _bench )
+    {
+        std::cout << "games: " << _pbn->games() << " errors: " << _pbn->errors().size()
+                  << " games/sec: " << (_pbn->games() / _secs)
+                  << " MB/sec: " << (_pbn->size() / _secs / 1e6)
+                  << " (NS total " << _total << ")\n";
+    }
+    std::cout << std::flush;
+    return _bad ? 1 : 0;
+}
@@ -5,11 +5,426 @@
  +========================================================================*/
 
 #include "Contract.h"
+#include "LiveBoard.h"
+#include "Scoring.h"
 
+#include <chrono>
+#include <cstring>
+#include <ctype.h>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
 
 using namespace bridge;
 
+namespace legacy
+{
+    // the nested switch scoring that Contract::score replaced, to check the table against
+    int as_integer( Contract::Level level )
+    {
+        switch ( level )
+        {
+        default:
+        case Contract::Level::L1 : return 1;
+        case Contract::Level::L2 : return 2;
+        case Contract::Level::L3 : return 3;
+        case Contract::Level::L4 : return 4;
+        case Contract::Level::L5 : return 5;
+        case Contract::Level::L6 : return 6;
+        case Contract::Level::L7 : return 7;
+        }
+    }
+
+    int slam( Contract::Level level, bool vul )
+    {
+        switch ( level )
+        {
+        case Contract::Level::L7 : return vul ? 1500 : 1000;
+        case Contract::Level::L6 : return vul ?  750 :  500;
+        default: return 0;
+        }
+    }
+
+    int minus( Contract const& c, int ut )
+    {
+        bool const  _vul{c.vul()};
+        switch ( c.dbld() )
+        {
+        case Contract::Dbld::NO   : return ut * (_vul ? 100 : 50);
+        case Contract::Dbld::YES  : return _vul ? 200 + (ut - 1) * 300 : 100 + (ut - 1) * 200 + (ut > 3 ? ut - 3 : 0) * 100;
+        case Contract::Dbld::AGAIN: return _vul ? 400 + (ut - 1) * 600 : 200 + (ut - 1) * 400 + (ut > 3 ? ut - 3 : 0) * 200;
+        default: return 0;
+        }
+    }
+
+    int trickscore( Contract const& c, int tricks )
+    {
+        switch ( c.rank() )
+        {
+        case Contract::Rank::NT : return 40 + 30 * (tricks - 1);
+        case Contract::Rank::MN : return 20 * tricks;
+        case Contract::Rank::MJ : return 30 * tricks;
+        default                 : return 0;
+        }
+    }
+
+    int overtricks( Contract const& c, int ot )
+    {
+        switch ( c.dbld() )
+        {
+        case Contract::Dbld::NO   : return ot * (c.rank() == Contract::Rank::MN ? 20 : 30);
+        case Contract::Dbld::YES  : return ot * (c.vul() ? 200 : 100);
+        case Contract::Dbld::AGAIN: return ot * (c.vul() ? 400 : 200);
+        default                   : return 0;
+        }
+    }
+
+    int plus( Contract const& c, int ot )
+    {
+        int _ts{0};
+        int _xtra{0};
+        switch ( c.dbld() )
+        {
+        case Contract::Dbld::NO   : _ts = trickscore( c, as_integer( c.level() ) ); break;
+        case Contract::Dbld::YES  : _ts = 2 * trickscore( c, as_integer( c.level() ) ); _xtra = 50; break;
+        case Contract::Dbld::AGAIN: _ts = 4 * trickscore( c, as_integer( c.level() ) ); _xtra = 100; break;
+        }
+        int _game = (_ts < 100 ? 50 : c.vul() ? 500 : 300);
+        return _ts + _xtra + overtricks( c, ot ) + _game + slam( c.level(), c.vul() );
+    }
+
+    int score( Contract const& c, int tricks )
+    {
+        if ( c.level() == Contract::Level::L0 || tricks < 0 || tricks > 13 ) { return 0; }
+        int _diff(tricks - 6 - as_integer( c.level() ));
+        return _diff < 0 ? -minus( c, -_diff ) : plus( c, _diff );
+    }
+
+    // the regex the string constructor used before Contract::parse
+    bool parse( std::string const& spec, Contract& out )
+    {
+        static std::regex const contractPattern("^([1-7])([CDHNScdhns])([xX]([xX])?)?$");
+        std::smatch     _m;
+        if ( !std::regex_match( spec, _m, contractPattern ) ) { return false; }
+        char const  _strain(static_cast<char>(::toupper( _m.str( 2 )[0] )));
+        out.level( static_cast<Contract::Level>(_m.str( 1 )[0] - '0') )
+           .rank( _strain == 'N' ? Contract::Rank::NT : _strain == 'C' || _strain == 'D' ? Contract::Rank::MN : Contract::Rank::MJ )
+           .dbld( _m.length( 4 ) > 0 ? Contract::Dbld::AGAIN : _m.length( 3 ) > 0 ? Contract::Dbld::YES : Contract::Dbld::NO );
+        return true;
+    }
+}
+
+bool operator==( Contract const& a, Contract const& b )
+{
+    return a.level() == b.level() && a.rank() == b.rank() && a.dbld() == b.dbld() && a.vul() == b.vul();
+}
+
+//!> contract strings, some malformed, through the regex and the parser
+bool parse_benchmark()
+{
+    using Clock = std::chrono::steady_clock;
+    static char const   _chars[] = "01234789CDHSNcdhsnTtXx ?";
+    std::size_t const   _count{1 << 18};
+    std::vector<std::string>    _specs(_count);
+    std::mt19937                _rng(2021);
+    for ( std::string& _spec : _specs )
+    {
+        _spec = {char('1' + _rng() % 7), "CDHSNcdhsn"[_rng() % 10]};
+        for ( auto _more(_rng() % 3); _more; --_more ) { _spec.push_back( "Xx"[_rng() % 2] ); }
+        if ( _rng() % 4 == 0 ) { _spec[_rng() % _spec.size()] = _chars[_rng() % (sizeof _chars - 1)]; }
+    }
+    std::vector<char const*>    _ptrs(_count);
+    std::vector<std::size_t>    _lens(_count);
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        _ptrs[_ndx] = _specs[_ndx].data();
+        _lens[_ndx] = _specs[_ndx].size();
+    }
+
+    std::vector<Contract>   _old(_count), _new(_count), _batch(_count);
+    std::unique_ptr<bool[]> _oldok(new bool[_count]), _newok(new bool[_count]), _batchok(new bool[_count]);
+    std::vector<char const*>    _why(_count, nullptr), _batchwhy(_count);
+    auto const  _t0(Clock::now());
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx ) { _oldok[_ndx] = legacy::parse( _specs[_ndx], _old[_ndx] ); }
+    auto const  _t1(Clock::now());
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx ) { _newok[_ndx] = Contract::parse( _ptrs[_ndx], _lens[_ndx], _new[_ndx], &_why[_ndx] ); }
+    auto const  _t2(Clock::now());
+    std::size_t const   _good{Contract::parse_batch( _count, _ptrs.data(), _lens.data(), _batch.data(), _batchok.get(), _batchwhy.data() )};
+    auto const  _t3(Clock::now());
+
+    std::size_t _differ{0}, _nt{0};
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        // the regex had no "NT"
+        if ( _newok[_ndx] && !_oldok[_ndx] && _specs[_ndx].find_first_of( "Tt" ) == 2 ) { ++_nt; continue; }
+        _differ += _oldok[_ndx] != _newok[_ndx] || _newok[_ndx] != _batchok[_ndx]
+                || !(_old[_ndx] == _new[_ndx]) || !(_new[_ndx] == _batch[_ndx]) || _why[_ndx] != _batchwhy[_ndx];
+    }
+    auto    _rate([&]( Clock::time_point from, Clock::time_point to )
+    {
+        return _count / std::chrono::duration<double>(to - from).count() / 1e6;
+    });
+    std::cout << "contracts: " << _count << ", well formed: " << _good << "\n"
+              << "regex: " << _rate( _t0, _t1 ) << " M/sec\n"
+              << "parse: " << _rate( _t1, _t2 ) << " M/sec\n"
+              << "parse batch: " << _rate( _t2, _t3 ) << " M/sec\n"
+              << "NT spellings: " << _nt << ", parses differing: " << _differ << std::endl;
+    return _differ == 0;
+}
+
+namespace
+{
+    struct Result
+    {
+        int score;
+        int imps;
+        int num;
+    };
+
+    struct IMPMethods
+    {
+        static int diff( Result const* a, Result const* b ) { return a->score - b->score; }
+        static void award( Result* r, int score, int num ) { r->imps = score; r->num = num; }
+    };
+
+    struct MPTMethods
+    {
+        static bool less( Result const* a, Result const* b ) { return a->score < b->score; }
+        static void award( Result* r, int score, int max ) { r->imps = score; r->num = max; }
+    };
+
+    struct MPTKeyMethods : MPTMethods
+    {
+        static int key( Result const* r ) { return r->score; }
+    };
+
+    //!> a board's results from random contracts
+    void deal_scores( std::mt19937& rng, std::vector<Result>& results )
+    {
+        for ( Result& _result : results )
+        {
+            _result.score = Contract::score( static_cast<Contract::Level>(1 + rng() % 7), static_cast<Contract::Rank>(rng() % 3),
+                                             static_cast<Contract::Dbld>(rng() % 3 / 2), rng() % 2, static_cast<int>(6 + rng() % 8) );
+        }
+    }
+
+    //!> matchpoints by comparator and by key; false if they differ
+    bool matchpoints( std::mt19937& rng, std::size_t tables, double* secs )
+    {
+        using Clock = std::chrono::steady_clock;
+        std::vector<Result>     _less(tables), _key(tables);
+        deal_scores( rng, _less );
+        _key = _less;
+        std::vector<Result*>    _cv[2];
+        for ( std::size_t _ndx{0}; _ndx < tables; ++_ndx )
+        {
+            _cv[0].push_back( &_less[_ndx] );
+            _cv[1].push_back( &_key[_ndx] );
+        }
+        auto const  _t0(Clock::now());
+        mpt_score<Result, MPTMethods>( _cv[0] );
+        auto const  _t1(Clock::now());
+        mpt_score<Result, MPTKeyMethods>( _cv[1] );
+        auto const  _t2(Clock::now());
+        secs[0] += std::chrono::duration<double>(_t1 - _t0).count();
+        secs[1] += std::chrono::duration<double>(_t2 - _t1).count();
+        for ( std::size_t _ndx{0}; _ndx < tables; ++_ndx )
+        {
+            if ( _less[_ndx].imps != _key[_ndx].imps || _less[_ndx].num != _key[_ndx].num ) { return false; }
+            if ( _ndx && _cv[1][_ndx - 1]->score > _cv[1][_ndx]->score ) { return false; }
+        }
+        return true;
+    }
+
+    //!> a board's results from random contracts; false if the two modes differ
+    bool cross_imps( std::mt19937& rng, std::size_t tables, double* secs )
+    {
+        using Clock = std::chrono::steady_clock;
+        std::vector<Result>     _pairs(tables), _sorted(tables);
+        deal_scores( rng, _pairs );
+        _sorted = _pairs;
+        std::vector<Result*>    _cv[2];
+        for ( std::size_t _ndx{0}; _ndx < tables; ++_ndx )
+        {
+            _cv[0].push_back( &_pairs[_ndx] );
+            _cv[1].push_back( &_sorted[_ndx] );
+        }
+        auto const  _t0(Clock::now());
+        imp_score<Result, IMPMethods>( _cv[0], IMPMode::PAIRS );
+        auto const  _t1(Clock::now());
+        imp_score<Result, IMPMethods>( _cv[1], IMPMode::SORTED );
+        auto const  _t2(Clock::now());
+        secs[0] += std::chrono::duration<double>(_t1 - _t0).count();
+        secs[1] += std::chrono::duration<double>(_t2 - _t1).count();
+        for ( std::size_t _ndx{0}; _ndx < tables; ++_ndx )
+        {
+            if ( _pairs[_ndx].imps != _sorted[_ndx].imps || _pairs[_ndx].num != _sorted[_ndx].num ) { return false; }
+        }
+        return true;
+    }
+}
+
+//!> both modes of imp_score on many small fields and a few large ones
+bool imp_benchmark()
+{
+    std::mt19937    _rng(2022);
+    std::size_t     _differ{0};
+    double          _secs[2]{0, 0};
+    for ( std::size_t _board{0}; _board < 10000; ++_board ) { _differ += !cross_imps( _rng, 2 + _board % 40, _secs ); }
+    double          _large[2]{0, 0};
+    for ( int _board{0}; _board < 5; ++_board ) { _differ += !cross_imps( _rng, 2000, _large ); }
+    std::cout << "cross-IMP boards differing: " << _differ << "\n"
+              << "2..41 tables, pairs: " << _secs[0] << " s, sorted: " << _secs[1] << " s\n"
+              << "2000 tables, pairs: " << _large[0] / 5 << " s/board, sorted: " << _large[1] / 5 << " s/board" << std::endl;
+    return _differ == 0;
+}
+
+//!> mpt_score with and without a key(), as imp_benchmark
+bool mpt_benchmark()
+{
+    std::mt19937    _rng(2023);
+    std::size_t     _differ{0};
+    double          _secs[2]{0, 0};
+    for ( std::size_t _board{0}; _board < 4000; ++_board ) { _differ += !matchpoints( _rng, 1 + _board % 1000, _secs ); }
+    double          _large[2]{0, 0};
+    for ( int _board{0}; _board < 20; ++_board ) { _differ += !matchpoints( _rng, 100000, _large ); }
+    std::cout << "matchpoint boards differing: " << _differ << "\n"
+              << "1..1000 tables, less: " << _secs[0] << " s, key: " << _secs[1] << " s\n"
+              << "100000 tables, less: " << _large[0] / 20 << " s/board, key: " << _large[1] / 20 << " s/board" << std::endl;
+    return _differ == 0;
+}
+
+//!> results entered, corrected and withdrawn at random; LiveBoard against mpt_score after each
+bool live_benchmark()
+{
+    using Clock = std::chrono::steady_clock;
+    std::mt19937    _rng(2024);
+    std::size_t     _differ{0};
+    for ( int _board{0}; _board < 200; ++_board )
+    {
+        int const               _pairs{1 + _board % 30};
+        LiveBoard               _live;
+        std::vector<Result>     _field(_pairs);
+        std::vector<bool>       _entered(_pairs, false);
+        for ( int _op{0}; _op < 200; ++_op )
+        {
+            int const   _pair(_rng() % _pairs);
+            if ( _rng() % 4 == 0 )
+            {
+                _differ += _live.erase( _pair ) != _entered[_pair];
+                _entered[_pair] = false;
+            }
+            else
+            {
+                std::vector<Result> _one(1);
+                deal_scores( _rng, _one );
+                _field[_pair].score = _one[0].score;
+                _entered[_pair] = true;
+                _live.set( _pair, _field[_pair].score );
+            }
+            std::vector<Result*>    _cv;
+            for ( int _ndx{0}; _ndx < _pairs; ++_ndx ) { if ( _entered[_ndx] ) { _cv.push_back( &_field[_ndx] ); } }
+            mpt_score<Result, MPTMethods>( _cv );
+            for ( int _ndx{0}; _ndx < _pairs; ++_ndx )
+            {
+                _differ += _entered[_ndx] ? _live.matchpoints( _ndx ) != _field[_ndx].imps || _live.top() != _field[_ndx].num
+                                          : _live.matchpoints( _ndx ) != -1;
+            }
+        }
+    }
+
+    // a session at 2000 tables: each result in turn, with one pair's standing after each
+    int const               _tables{2000};
+    std::vector<Result>     _field(_tables);
+    deal_scores( _rng, _field );
+    LiveBoard               _live;
+    long                    _sum[2]{0, 0};
+    auto const  _t0(Clock::now());
+    for ( int _ndx{0}; _ndx < _tables; ++_ndx )
+    {
+        _live.set( _ndx, _field[_ndx].score );
+        _sum[0] += _live.matchpoints( _ndx / 2 );
+    }
+    auto const  _t1(Clock::now());
+    std::vector<Result*>    _cv;
+    for ( int _ndx{0}; _ndx < _tables; ++_ndx )
+    {
+        _cv.push_back( &_field[_ndx] );
+        std::vector<Result*>    _now(_cv);
+        mpt_score<Result, MPTMethods>( _now );
+        _sum[1] += _field[_ndx / 2].imps;
+    }
+    auto const  _t2(Clock::now());
+    std::cout << "live boards differing: " << _differ + (_sum[0] != _sum[1]) << "\n"
+              << _tables << " results one by one, live: " << std::chrono::duration<double>(_t1 - _t0).count()
+              << " s, rescoring: " << std::chrono::duration<double>(_t2 - _t1).count() << " s" << std::endl;
+    return _differ == 0 && _sum[0] == _sum[1];
+}
+
+// every entry against the old code, then random contracts three ways, then parsing, cross-IMPs, matchpoints and live matchpoints
+int benchmark()
+{
+    std::size_t _bad{0};
+    for ( int _level{0}; _level <= 7; ++_level )
+        for ( int _rank{0}; _rank < 3; ++_rank )
+            for ( int _dbld{0}; _dbld < 3; ++_dbld )
+                for ( int _vul{0}; _vul < 2; ++_vul )
+                    for ( int _tricks{-1}; _tricks <= 14; ++_tricks )
+                    {
+                        Contract const  _c(static_cast<Contract::Level>(_level), static_cast<Contract::Rank>(_rank),
+                                           static_cast<Contract::Dbld>(_dbld), _vul != 0);
+                        _bad += _c.score( _tricks ) != legacy::score( _c, _tricks );
+                    }
+
+    using Clock = std::chrono::steady_clock;
+    std::size_t const           _count{1 << 22};
+    std::vector<std::uint8_t>   _level(_count), _rank(_count), _dbld(_count), _vul(_count), _tricks(_count);
+    std::mt19937                _rng(2020);
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        _level[_ndx]  = static_cast<std::uint8_t>(_rng() % 8);
+        _rank[_ndx]   = static_cast<std::uint8_t>(_rng() % 3);
+        _dbld[_ndx]   = static_cast<std::uint8_t>(_rng() % 3);
+        _vul[_ndx]    = static_cast<std::uint8_t>(_rng() % 2);
+        _tricks[_ndx] = static_cast<std::uint8_t>(_rng() % 14);
+    }
+    std::vector<int>    _old(_count), _new(_count), _batch(_count);
+    auto const  _t0(Clock::now());
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        _old[_ndx] = legacy::score( Contract(static_cast<Contract::Level>(_level[_ndx]), static_cast<Contract::Rank>(_rank[_ndx]),
+                                             static_cast<Contract::Dbld>(_dbld[_ndx]), _vul[_ndx] != 0), _tricks[_ndx] );
+    }
+    auto const  _t1(Clock::now());
+    for ( std::size_t _ndx{0}; _ndx < _count; ++_ndx )
+    {
+        _new[_ndx] = Contract(static_cast<Contract::Level>(_level[_ndx]), static_cast<Contract::Rank>(_rank[_ndx]),
+                              static_cast<Contract::Dbld>(_dbld[_ndx]), _vul[_ndx] != 0).score( _tricks[_ndx] );
+    }
+    auto const  _t2(Clock::now());
+    Contract::score_batch( _count, _level.data(), _rank.data(), _dbld.data(), _vul.data(), _tricks.data(), _batch.data() );
+    auto const  _t3(Clock::now());
+
+    auto    _rate([&]( Clock::time_point from, Clock::time_point to )
+    {
+        return _count / std::chrono::duration<double>(to - from).count() / 1e6;
+    });
+    bool const  _same{_old == _new && _old == _batch};
+    std::cout << "table entries differing: " << _bad << "\n"
+              << "switches: " << _rate( _t0, _t1 ) << " M/sec\n"
+              << "table: " << _rate( _t1, _t2 ) << " M/sec\n"
+              << "batch: " << _rate( _t2, _t3 ) << " M/sec\n"
+              << (_same ? "same scores" : "DIFFERENT scores") << std::endl;
+    bool const  _parsed{parse_benchmark()};
+    bool const  _imps{imp_benchmark()};
+    bool const  _mpts{mpt_benchmark()};
+    bool const  _live{live_benchmark()};
+    return _bad == 0 && _same && _parsed && _imps && _mpts && _live ? 0 : 1;
+}
+
 int main( int ac, char* av[])
 {
     auto    _level{Contract::Level::L1};
@@ -19,6 +434,7 @@ int main( int ac, char* av[])
     int     _rslt{0};
 
     if ( ac < 2 ) { std::cerr << "Need a contract and result!" << std::endl; return 1; }
+    if ( std::strcmp( av[1], "-b" ) == 0 ) { return benchmark(); }
 
     char*   _ptr = av[1];
 
@@ -11,6 +11,8 @@
 #include <vector>
 #include <array>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
     /**
      * @file Scoring.h: Scoring routines.
@@ -19,6 +21,7 @@
      * The second template parameter is a struct defining two methods:
      * (1) A comparison function between two pointers.
      * (2) An assignment function for the computed score.
+     * Matchpoints may also take (3) an integer key, see MPTCellMethods.
      */
 namespace bridge
 {
@@ -30,10 +33,61 @@ namespace bridge
         static bool less( Cell const*, Cell const* ) { return false; }
         // max is the highest possible score
         static void award( Cell*, int score, int max ) {}
+        // optional: an integer in the order of less(), equal for ties, e.g. the score itself
+        // static int key( Cell const* );
     };
 
+namespace
+{
+    template<typename Methods, typename Cell, typename = void>
+    struct HasKey : std::false_type {};
+
+    template<typename Methods, typename Cell>
+    struct HasKey<Methods, Cell, decltype(void(Methods::key( std::declval<Cell const*>() )))> : std::true_type {};
+
+    /**
+     * Counting sort on the keys, when they span little more than the field:
+     * bridge scores are multiples of 10 within 7600 either way, so from a
+     * few hundred tables on. Otherwise false, for the comparator.
+     */
+    template<typename Cell, typename Methods>
+    bool mpt_order( std::vector<Cell*>& cv, std::vector<int>& keys, std::true_type )
+    {
+        std::size_t const   _size{cv.size()};
+        std::vector<int>    _raw(_size);
+        for ( std::size_t _ndx{0}; _ndx < _size; ++_ndx ) { _raw[_ndx] = Methods::key( cv[_ndx] ); }
+        auto const          _range(std::minmax_element( _raw.begin(), _raw.end() ));
+        int const           _lo{*_range.first};
+        long const          _span{long(*_range.second) - _lo + 1};
+        if ( _span > long(32 * _size) ) { return false; }
+
+        std::vector<int>    _start(_span + 1, 0);  // then where each key goes
+        for ( int const _key : _raw ) { ++_start[_key - _lo + 1]; }
+        for ( long _ndx{1}; _ndx <= _span; ++_ndx ) { _start[_ndx] += _start[_ndx - 1]; }
+        std::vector<Cell*>  _sorted(_size);
+        keys.resize( _size );
+        for ( std::size_t _ndx{0}; _ndx < _size; ++_ndx )
+        {
+            int const   _to{_start[_raw[_ndx] - _lo]++};
+            _sorted[_to] = cv[_ndx];
+            keys[_to]    = _raw[_ndx];
+        }
+        cv.swap( _sorted );
+        return true;
+    }
+
+    // no key(): the comparator path
+    template<typename Cell, typename Methods>
+    bool mpt_order( std::vector<Cell*>&, std::vector<int>&, std::false_type )
+    {
+        return false;
+    }
+}
+
     /**
      * @function mpt_score: Matchpoint scoring.
+     * With a key() in Methods a large field is sorted on the keys and ties
+     * found by comparing them, O(n) for bridge scores.
      */
     template<typename Cell, typename Methods = MPTCellMethods<Cell>>
     bool mpt_score( std::vector<Cell*>& cv )
@@ -43,7 +97,7 @@ namespace bridge
         if ( cv.size() == 0 ) { return false; }
         if ( cv.size() == 1 ) 
         { 
-            Methods::award( *cv[0], 1, 2 );
+            Methods::award( cv[0], 1, 2 );
             return true; 
         }
  
@@ -51,6 +105,20 @@ namespace bridge
         int         _worse{0};
         int         _ties{0};
 
+        std::vector<int>    _keys;
+        if ( mpt_order<Cell, Methods>( cv, _keys, HasKey<Methods, Cell>{} ) )
+        {
+            std::size_t _hound{0};
+            for ( std::size_t _fox{1}; _fox <= cv.size(); ++_fox )
+            {
+                if ( _fox < cv.size() && _keys[_fox] == _keys[_hound] ) { ++_ties; continue; }
+                for ( int const _score(_ties + 2 * _worse); _hound < _fox; ++_hound ) { Methods::award( cv[_hound], _score, _max ); }
+                _worse += 1 + _ties;
+                _ties = 0;
+            }
+            return true;
+        }
+
         // sort lowest to highest and then fox+hound pattern to detect ties 
         std::sort( cv.begin(), cv.end(), Methods::less );
         auto        _fox{cv.begin()};
@@ -107,17 +175,59 @@ namespace
         static void award( Cell*, int score, int num ) {}
     };
 
+    /**
+     * PAIRS compares every two results, O(n^2).
+     * SORTED needs diff() to be a true difference, diff(a, b) == diff(a, c) - diff(b, c),
+     * as any score difference is: it puts the results in order once, then for each
+     * of the 24 steps of the scale counts the results that many points below and
+     * above each one with two pointers, O(n log n + 24n). The awards are the same.
+     */
+    enum class IMPMode
+    {
+        PAIRS, SORTED
+    };
+
     /**
      * @function imp_score: Cross-IMPs scoring.
      */
     template<typename Cell, typename Methods = IMPCellMethods<Cell>>
-    bool imp_score( std::vector<Cell*>& cv )
+    bool imp_score( std::vector<Cell*>& cv, IMPMode mode = IMPMode::PAIRS )
     {
         // sanity checks?
         int                 _max((int)cv.size());
         if ( _max < 2 ) { return false; }
         std::vector<int>    _scores(cv.size(), 0); // scratch
         //
+        if ( mode == IMPMode::SORTED )
+        {
+            std::vector<int>    _value(cv.size());     // against the first result
+            std::vector<int>    _order(cv.size());
+            for ( int _ndx{0}; _ndx < _max; ++_ndx )
+            {
+                _value[_ndx] = Methods::diff( cv[_ndx], cv[0] );
+                _order[_ndx] = _ndx;
+            }
+            std::sort( _order.begin(), _order.end(), [&_value]( int a, int b ) { return _value[a] < _value[b]; } );
+            std::vector<int>    _sorted(cv.size());
+            for ( int _ndx{0}; _ndx < _max; ++_ndx ) { _sorted[_ndx] = _value[_order[_ndx]]; }
+
+            // raw_imps(d) is the number of steps below |d|, signed: each step
+            // gains one for every result more than it below, loses one for every one above
+            for ( int const _step : scale )
+            {
+                int     _below{0};  // results < value - step
+                int     _upto{0};   // results <= value + step
+                for ( int _ndx{0}; _ndx < _max; ++_ndx )
+                {
+                    int const   _mine{_sorted[_ndx]};
+                    while ( _sorted[_below] < _mine - _step ) { ++_below; }
+                    while ( _upto < _max && _sorted[_upto] <= _mine + _step ) { ++_upto; }
+                    _scores[_order[_ndx]] += _below - (_max - _upto);
+                }
+            }
+            for ( int _ndx{0}; _ndx < _max; ++_ndx ) { Methods::award( cv[_ndx], _scores[_ndx], _max - 1 ); }
+            return true;
+        }
         for ( int _hound{0}; _hound < _max; ++_hound )
         {
             for ( int _fox{_hound + 1}; _fox < _max; ++_fox )
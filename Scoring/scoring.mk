@@ -1,19 +1,26 @@
 
-PROGRAMS := Score
+PROGRAMS := Score ParScore PbnRead
 
-VPATH = ../Scoring
+VPATH = ../Scoring ../Deck ../Utility
 
 CXX = g++
 CXXFLAGS = -pthread -m64 -std=c++14 -Wall
 
-INCLUDES = -I ../Utility
+INCLUDES = -I ../Utility -I ../Deck
+DECKOBJS = Deck.o Deal.o Codec.o Bitboard.o DealWriter.o
 
 .cpp.o:
 	$(CXX) $(CXXFLAGS) $(INCLUDES) -c $< -o $@
 
 all: $(PROGRAMS)
 
-Score: Score.o Contract.o
+Score: Score.o Contract.o LiveBoard.o
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+ParScore: ParScore.o Par.o Contract.o
+	$(CXX) $(CXXFLAGS) -o $@ $^
+
+PbnRead: PbnRead.o PbnFile.o Contract.o StrFile.o $(DECKOBJS)
 	$(CXX) $(CXXFLAGS) -o $@ $^
 
 clean:
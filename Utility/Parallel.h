@@ -0,0 +1,91 @@
+/** ======================================================================+
+ + Copyright @2020-2025 Arjun Ray
+ + Released under MIT License
+ + see https://mit-license.org
+ +========================================================================*/
+#pragma once
+#ifndef UTILITY_PARALLEL_H
+#define UTILITY_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Utility
+{
+    /**
+     * Parallel.
+     * Loops over [0, count) on a pool of threads, made for the one loop and
+     * joined before returning. slices() gives each thread one contiguous
+     * range, for work of even cost; each() has the threads take items off a
+     * shared counter, for work whose cost varies. With one thread the loop
+     * runs on the caller's.
+     */
+    class Parallel
+    {
+    public:
+        //!> takes the next item into 'ndx'; false when there are none left
+        class Next
+        {
+        public:
+            Next(std::atomic<std::size_t>& next, std::size_t count) : next_(next), count_(count) {}
+            bool operator()( std::size_t& ndx ) { return (ndx = next_++) < count_; }
+
+        private:
+            std::atomic<std::size_t>&   next_;
+            std::size_t                 count_;
+        };
+
+        //!> threads for 'count' items, at least 'grain' each; 0 asks for one per core
+        static unsigned threads( unsigned threads, std::size_t count, std::size_t grain = 1 )
+        {
+            if ( threads == 0 ) { threads = std::max( 1u, std::thread::hardware_concurrency() ); }
+            grain = std::max<std::size_t>( grain, 1 );
+            return static_cast<unsigned>(std::max<std::size_t>( 1, std::min<std::size_t>( threads, (count + grain - 1) / grain ) ));
+        }
+
+        //!> work( begin, end, slice ) on contiguous slices, one per thread;
+        //!> returns the number of slices, at most threads( threads, count, grain )
+        template<typename Work>
+        static unsigned slices( std::size_t count, unsigned threads, std::size_t grain, Work&& work )
+        {
+            threads = Parallel::threads( threads, count, grain );
+            if ( threads == 1 )
+            {
+                work( std::size_t(0), count, 0u );
+                return 1;
+            }
+            std::vector<std::thread>    _pool;
+            std::size_t const           _size{(count + threads - 1) / threads};
+            unsigned                    _slice{0};
+            for ( std::size_t _begin{0}; _begin < count; _begin += _size, ++_slice )
+            {
+                _pool.emplace_back( work, _begin, std::min( count, _begin + _size ), _slice );
+            }
+            for ( auto& _thread : _pool ) { _thread.join(); }
+            return _slice;
+        }
+
+        //!> worker( next ) once on each thread, which then calls next( ndx ) for items
+        template<typename Worker>
+        static void each( std::size_t count, unsigned threads, Worker&& worker )
+        {
+            threads = Parallel::threads( threads, count );
+            std::atomic<std::size_t>    _next{0};
+            auto    _run([&]()
+            {
+                Next    _items(_next, count);
+                worker( _items );
+            });
+            if ( threads == 1 ) { _run(); return; }
+            std::vector<std::thread>    _pool;
+            for ( unsigned _ndx{0}; _ndx < threads; ++_ndx ) { _pool.emplace_back( _run ); }
+            for ( auto& _thread : _pool ) { _thread.join(); }
+        }
+    };
+
+} // namespace Utility
+
+#endif // UTILITY_PARALLEL_H